@@ -4,13 +4,73 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../src/AuroraPlugin.cpp 
+../src/AuroraPlugin.cpp \
+../src/ColorCorrection.cpp \
+../src/ColorMatrix.cpp \
+../src/EnergyEnvelope.cpp \
+../src/FrameCompositor.cpp \
+../src/FrameDeltaFilter.cpp \
+../src/FrameScheduler.cpp \
+../src/FrameSliceTable.cpp \
+../src/FrameTrace.cpp \
+../src/LayoutGeometry.cpp \
+../src/Logger.cpp \
+../src/PaletteGradient.cpp \
+../src/PanelAdjacency.cpp \
+../src/PanelCalibration.cpp \
+../src/PanelDistanceField.cpp \
+../src/PanelOrdering.cpp \
+../src/PanelPropagation.cpp \
+../src/PointArray.cpp \
+../src/PowerLimiter.cpp \
+../src/Profiler.cpp \
+../src/TransitionPlanner.cpp 
 
 OBJS += \
-./src/AuroraPlugin.o 
+./src/AuroraPlugin.o \
+./src/ColorCorrection.o \
+./src/ColorMatrix.o \
+./src/EnergyEnvelope.o \
+./src/FrameCompositor.o \
+./src/FrameDeltaFilter.o \
+./src/FrameScheduler.o \
+./src/FrameSliceTable.o \
+./src/FrameTrace.o \
+./src/LayoutGeometry.o \
+./src/Logger.o \
+./src/PaletteGradient.o \
+./src/PanelAdjacency.o \
+./src/PanelCalibration.o \
+./src/PanelDistanceField.o \
+./src/PanelOrdering.o \
+./src/PanelPropagation.o \
+./src/PointArray.o \
+./src/PowerLimiter.o \
+./src/Profiler.o \
+./src/TransitionPlanner.o 
 
 CPP_DEPS += \
-./src/AuroraPlugin.d 
+./src/AuroraPlugin.d \
+./src/ColorCorrection.d \
+./src/ColorMatrix.d \
+./src/EnergyEnvelope.d \
+./src/FrameCompositor.d \
+./src/FrameDeltaFilter.d \
+./src/FrameScheduler.d \
+./src/FrameSliceTable.d \
+./src/FrameTrace.d \
+./src/LayoutGeometry.d \
+./src/Logger.d \
+./src/PaletteGradient.d \
+./src/PanelAdjacency.d \
+./src/PanelCalibration.d \
+./src/PanelDistanceField.d \
+./src/PanelOrdering.d \
+./src/PanelPropagation.d \
+./src/PointArray.d \
+./src/PowerLimiter.d \
+./src/Profiler.d \
+./src/TransitionPlanner.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
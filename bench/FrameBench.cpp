@@ -0,0 +1,190 @@
+/*
+ * FrameBench.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+/*
+ * Times the passes getPluginFrame runs over the composed frame before it is sent: the color matrix, the color
+ * correction, the panel calibration and the power limiter. The frames have the panels of generated layouts, from a
+ * handful to 100000, with every panel in the calibration file and every pass set up so that none is skipped.
+ *
+ *   frame_bench [calibrationDirectory] [panelsCount...]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "LayoutFixture.h"
+#include "LayoutGeometry.h"
+#include "FrameCompositor.h"
+#include "ColorMatrix.h"
+#include "ColorCorrection.h"
+#include "PanelCalibration.h"
+#include "PowerLimiter.h"
+#include "MonotonicClock.h"
+
+using namespace std;
+
+/* Constants */
+
+static const int DEFAULT_PANELS_COUNTS[] = {3, 100, 1000, 10000, 100000};
+
+// Enough channels in a sample for the timer resolution not to matter, however small the frame.
+static const int MINIMUM_CHANNELS_PER_SAMPLE = 1 << 20;
+
+static const int SAMPLES_COUNT = 15;
+
+enum FramePass {
+    FRAME_PASS_COLOR_MATRIX = 0,
+    FRAME_PASS_COLOR_CORRECTION,
+    FRAME_PASS_CALIBRATION,
+    FRAME_PASS_POWER_LIMIT,
+    FRAME_PASSES_COUNT
+};
+
+static const char* FRAME_PASS_NAMES[FRAME_PASSES_COUNT] = {
+    "colorMatrix",
+    "colorCorrection",
+    "calibration",
+    "powerLimit"
+};
+
+/* Helpers */
+
+/**
+ * Internal helper: write a calibration file with a different gain and offset for every panel
+ * @return: false if the file cannot be written
+ */
+static bool writeCalibrationFile(const char* path, const LayoutGeometry* geometry) {
+    FILE* file = fopen(path, "w");
+
+    if (!file) {
+        return false;
+    }
+
+    fprintf(file, "# panelId redGain greenGain blueGain redOffset greenOffset blueOffset\n");
+
+    for (int panelIndex = 0; panelIndex < geometry->nPanels; panelIndex++) {
+        fprintf(file, "%d %d %d %d %d %d %d\n", geometry->panelIds[panelIndex],
+                80 + panelIndex % 40, 90 + panelIndex % 20, 70 + panelIndex % 50,
+                panelIndex % 5 - 2, panelIndex % 3 - 1, panelIndex % 7 - 3);
+    }
+
+    return fclose(file) == 0;
+}
+
+/**
+ * Internal helper: run one pass over the frame
+ */
+static void runFramePass(int pass, const ColorMatrix* colorMatrix, ColorCorrection* colorCorrection,
+                         const PanelCalibration* calibration, PowerLimiter* powerLimiter, uint8_t* channels, int nPanels) {
+    switch (pass) {
+        case FRAME_PASS_COLOR_MATRIX:
+            applyColorMatrix(colorMatrix, channels, nPanels);
+            break;
+        case FRAME_PASS_COLOR_CORRECTION:
+            applyColorCorrection(colorCorrection, channels, nPanels, true);
+            break;
+        case FRAME_PASS_CALIBRATION:
+            applyPanelCalibration(calibration, channels, nPanels);
+            break;
+        default:
+            applyPowerLimiter(powerLimiter, channels, nPanels);
+            break;
+    }
+}
+
+/* Main */
+
+int main(int argc, char** argv) {
+    const char* calibrationDirectory = argc > 1 ? argv[1] : "/tmp";
+
+    vector<int> panelsCounts;
+
+    for (int argumentIndex = 2; argumentIndex < argc; argumentIndex++) {
+        panelsCounts.push_back(atoi(argv[argumentIndex]));
+    }
+
+    if (panelsCounts.empty()) {
+        panelsCounts.assign(DEFAULT_PANELS_COUNTS, DEFAULT_PANELS_COUNTS + sizeof(DEFAULT_PANELS_COUNTS) / sizeof(int));
+    }
+
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/frame_bench.calibration", calibrationDirectory);
+
+    printf("[frame] median over %d samples, in nanoseconds per panel\n", SAMPLES_COUNT);
+
+    for (int nPanels : panelsCounts) {
+        LayoutGeometry geometry;
+        generateLayoutGeometry(&geometry, nPanels, SHAPE_TRIANGLE, GENERATED_LAYOUT_BLOB, false);
+
+        PanelCalibration calibration;
+
+        if (!writeCalibrationFile(path, &geometry) || loadPanelCalibration(&calibration, path, geometry.panelIds, nPanels) != nPanels) {
+            fprintf(stderr, "[frame] cannot go through %s\n", path);
+            return 1;
+        }
+
+        ColorMatrix colorMatrix;
+        initColorMatrix(&colorMatrix, 1, 100, 90, 80);
+
+        ColorCorrection colorCorrection;
+        initColorCorrection(&colorCorrection, 70, true, true);
+
+        PowerLimiter powerLimiter;
+        initPowerLimiter(&powerLimiter, 30, nPanels);
+
+        // A bright frame, so that the power limiter has to scale it.
+        int nChannels = nPanels * FRAME_CHANNELS_COUNT;
+        vector<uint8_t> composedFrame(nChannels);
+
+        for (int index = 0; index < nChannels; index++) {
+            composedFrame[index] = 128 + (index * 37) % 128;
+        }
+
+        vector<uint8_t> frame(nChannels);
+        int iterationsCount = max(1, MINIMUM_CHANNELS_PER_SAMPLE / nChannels);
+
+        // Every pass works in place, so each one starts over from a copy of the composed frame, timed on its own too.
+        uint64_t medians[FRAME_PASSES_COUNT + 1];
+
+        for (int pass = 0; pass <= FRAME_PASSES_COUNT; pass++) {
+            vector<uint64_t> samples;
+
+            for (int sampleIndex = 0; sampleIndex < SAMPLES_COUNT; sampleIndex++) {
+                uint64_t startTime = monotonicNanoseconds();
+
+                for (int iteration = 0; iteration < iterationsCount; iteration++) {
+                    memcpy(frame.data(), composedFrame.data(), nChannels);
+
+                    if (pass < FRAME_PASSES_COUNT) {
+                        runFramePass(pass, &colorMatrix, &colorCorrection, &calibration, &powerLimiter, frame.data(), nPanels);
+                    }
+                }
+
+                samples.push_back(monotonicNanoseconds() - startTime);
+            }
+
+            nth_element(samples.begin(), samples.begin() + SAMPLES_COUNT / 2, samples.end());
+            medians[pass] = samples[SAMPLES_COUNT / 2];
+        }
+
+        printf("[frame] %6d panels:", nPanels);
+
+        for (int pass = 0; pass < FRAME_PASSES_COUNT; pass++) {
+            uint64_t duration = medians[pass] > medians[FRAME_PASSES_COUNT] ? medians[pass] - medians[FRAME_PASSES_COUNT] : 0;
+
+            printf(" %s %.2f", FRAME_PASS_NAMES[pass], (double)duration / iterationsCount / nPanels);
+        }
+
+        printf("\n");
+    }
+
+    remove(path);
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * FrameTraceReplay.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "FrameTraceReplay.h"
+#include "MonotonicClock.h"
+
+/* Helpers */
+
+/**
+ * Internal helper: read one field, bounded by the end of the record
+ * @return: the cursor past the field, NULL if the field overruns the record
+ */
+static const uint8_t* readField(const uint8_t* cursor, const uint8_t* end, int* value) {
+    int32_t field;
+
+    if (cursor == NULL || end - cursor < (ptrdiff_t)sizeof(field)) {
+        return NULL;
+    }
+
+    memcpy(&field, cursor, sizeof(field));
+    *value = field;
+
+    return cursor + sizeof(field);
+}
+
+static void sleepUntil(uint64_t deadline) {
+    uint64_t now = monotonicNanoseconds();
+
+    if (deadline <= now) {
+        return;
+    }
+
+    struct timespec duration;
+    duration.tv_sec = (deadline - now) / 1000000000;
+    duration.tv_nsec = (deadline - now) % 1000000000;
+
+    nanosleep(&duration, NULL);
+}
+
+/* API */
+
+bool openFrameTraceReader(FrameTraceReader* reader, const char* path) {
+    reader->data = NULL;
+    reader->size = 0;
+    reader->offset = 0;
+    reader->maximumFrames = 0;
+
+    int file = open(path, O_RDONLY);
+
+    if (file < 0) {
+        return false;
+    }
+
+    struct stat status;
+
+    if (fstat(file, &status) != 0 || (size_t)status.st_size < sizeof(FrameTraceHeader)) {
+        close(file);
+        return false;
+    }
+
+    void* data = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+    close(file);
+
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    FrameTraceHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    if (header.magic != FRAME_TRACE_MAGIC || header.version != FRAME_TRACE_VERSION) {
+        munmap(data, status.st_size);
+        return false;
+    }
+
+    reader->data = (const uint8_t*)data;
+    reader->size = status.st_size;
+    reader->offset = sizeof(header);
+    reader->maximumFrames = header.maximumFrames;
+
+    return true;
+}
+
+bool readTraceFrame(FrameTraceReader* reader, Frame_t* frames, int* nFrames, int* sleepTime, uint64_t* timestamp) {
+    if (reader->offset + sizeof(FrameTraceRecordHeader) > reader->size) {
+        return false;
+    }
+
+    FrameTraceRecordHeader header;
+    memcpy(&header, reader->data + reader->offset, sizeof(header));
+
+    if (reader->offset + sizeof(header) + header.payloadSize > reader->size || (int)header.nFrames > reader->maximumFrames) {
+        return false;
+    }
+
+    const uint8_t* cursor = reader->data + reader->offset + sizeof(header);
+    const uint8_t* end = cursor + header.payloadSize;
+
+    // Every read is bounded by the record, so a corrupt mask cannot walk past it, nor past the mapping.
+    for (unsigned int index = 0; index < header.nFrames; index++) {
+        if (cursor >= end) {
+            return false;
+        }
+
+        Frame_t& frame = frames[index];
+        uint8_t mask = *cursor++;
+
+        if (mask & FRAME_TRACE_FIELD_PANEL_ID) {
+            cursor = readField(cursor, end, &frame.panelId);
+        }
+        if (mask & FRAME_TRACE_FIELD_R) {
+            cursor = readField(cursor, end, &frame.r);
+        }
+        if (mask & FRAME_TRACE_FIELD_G) {
+            cursor = readField(cursor, end, &frame.g);
+        }
+        if (mask & FRAME_TRACE_FIELD_B) {
+            cursor = readField(cursor, end, &frame.b);
+        }
+        if (mask & FRAME_TRACE_FIELD_TRANS_TIME) {
+            cursor = readField(cursor, end, &frame.transTime);
+        }
+
+        if (cursor == NULL) {
+            return false;
+        }
+    }
+
+    // A record that decodes to fewer bytes than it claims is just as corrupt.
+    if (cursor != end) {
+        return false;
+    }
+
+    *nFrames = header.nFrames;
+    *sleepTime = header.sleepTime;
+    *timestamp = header.timestamp;
+
+    reader->offset += sizeof(header) + header.payloadSize;
+
+    return true;
+}
+
+void closeFrameTraceReader(FrameTraceReader* reader) {
+    if (reader->data) {
+        munmap((void*)reader->data, reader->size);
+    }
+
+    reader->data = NULL;
+    reader->size = 0;
+    reader->offset = 0;
+}
+
+int replayFrameTrace(const char* path, FrameTraceCallback callback, void* context, bool realTime) {
+    FrameTraceReader reader;
+
+    if (!openFrameTraceReader(&reader, path)) {
+        return -1;
+    }
+
+    Frame_t* frames = new Frame_t[reader.maximumFrames]();
+
+    int nFrames = 0;
+    int sleepTime = 0;
+    uint64_t timestamp = 0;
+    uint64_t startTime = monotonicNanoseconds();
+    int recordsCount = 0;
+
+    while (readTraceFrame(&reader, frames, &nFrames, &sleepTime, &timestamp)) {
+        if (realTime) {
+            sleepUntil(startTime + timestamp);
+        }
+
+        callback(context, frames, nFrames, sleepTime);
+
+        recordsCount++;
+    }
+
+    delete [] frames;
+
+    closeFrameTraceReader(&reader);
+
+    return recordsCount;
+}
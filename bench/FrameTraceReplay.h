@@ -0,0 +1,55 @@
+/*
+ * FrameTraceReplay.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef BENCH_FRAMETRACEREPLAY_H_
+#define BENCH_FRAMETRACEREPLAY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FrameTrace.h"
+
+/*
+ * The reading side of the traces written by FrameTraceRecorder, see FrameTrace.h for the layout.
+ */
+
+struct FrameTraceReader {
+	const uint8_t* data;				/*the mapped file*/
+	size_t size;
+	size_t offset;						/*where the next record starts*/
+	int maximumFrames;
+};
+
+/**
+ * @description: map a trace file for reading
+ * @return: true on success, false if the file cannot be mapped or is not a trace
+ */
+bool openFrameTraceReader(FrameTraceReader* reader, const char* path);
+
+/**
+ * @description: decode the next record of the trace
+ * @params frames: a buffer of at least reader->maximumFrames elements, holding the previous record on entry
+ * @params nFrames, sleepTime, timestamp: filled from the record
+ * @return: true if a record was read, false at the end of the trace or if the record is truncated or corrupt,
+ * in which case frames may be partly overwritten and the reader stays on the record
+ */
+bool readTraceFrame(FrameTraceReader* reader, Frame_t* frames, int* nFrames, int* sleepTime, uint64_t* timestamp);
+
+/**
+ * @description: unmap the trace file
+ */
+void closeFrameTraceReader(FrameTraceReader* reader);
+
+typedef void (*FrameTraceCallback)(void* context, const Frame_t* frames, int nFrames, int sleepTime);
+
+/**
+ * @description: stream a whole trace to a callback
+ * @params realTime: whether to wait between records as long as they were originally apart, or to go at full speed
+ * @return: the number of records replayed, -1 if the trace cannot be opened
+ */
+int replayFrameTrace(const char* path, FrameTraceCallback callback, void* context, bool realTime);
+
+#endif /* BENCH_FRAMETRACEREPLAY_H_ */
@@ -0,0 +1,130 @@
+/*
+ * GeometryCompare.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+/*
+ * Compares the dumps geometry_dump prints with each geometry backend. Panel ids, slice contents and probe results
+ * have to match exactly, coordinates only within the precision Q16.16 keeps: a fixed error, plus one relative to the
+ * distance from the origin since the sine and cosine of a rotation are rounded too.
+ *
+ *   geometry_compare doubleDump fixedDump
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Constants */
+
+/*in layout units*/
+static const double COORDINATE_TOLERANCE = 0.05;
+
+/*four times the 2^-16 rounding of a sine, for the error accumulated over the rotation*/
+static const double COORDINATE_RELATIVE_TOLERANCE = 1.0 / 16384;
+
+static const int MAXIMUM_TOKEN_LENGTH = 64;
+
+/* Helpers */
+
+/**
+ * Internal helper: read the next whitespace separated token
+ * @return: false at the end of the file
+ */
+static bool readToken(FILE* file, char* token, int* line) {
+    int character;
+
+    while ((character = fgetc(file)) != EOF && (character == ' ' || character == '\n')) {
+        if (character == '\n') {
+            (*line)++;
+        }
+    }
+
+    if (character == EOF) {
+        return false;
+    }
+
+    int length = 0;
+
+    do {
+        if (length < MAXIMUM_TOKEN_LENGTH - 1) {
+            token[length++] = (char)character;
+        }
+    } while ((character = fgetc(file)) != EOF && character != ' ' && character != '\n');
+
+    if (character != EOF) {
+        ungetc(character, file);
+    }
+
+    token[length] = '\0';
+
+    return true;
+}
+
+/**
+ * Internal helper: compare a token of each dump, coordinates with a tolerance and anything else exactly
+ */
+static bool tokensMatch(const char* firstToken, const char* secondToken) {
+    if (strchr(firstToken, '.') && strchr(secondToken, '.')) {
+        double first = atof(firstToken);
+
+        return fabs(first - atof(secondToken)) <= COORDINATE_TOLERANCE + fabs(first) * COORDINATE_RELATIVE_TOLERANCE;
+    }
+
+    return strcmp(firstToken, secondToken) == 0;
+}
+
+/* Main */
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: geometry_compare doubleDump fixedDump\n");
+        return 2;
+    }
+
+    FILE* firstFile = fopen(argv[1], "r");
+    FILE* secondFile = fopen(argv[2], "r");
+
+    if (!firstFile || !secondFile) {
+        fprintf(stderr, "[compare] cannot open the dumps\n");
+        return 2;
+    }
+
+    char firstToken[MAXIMUM_TOKEN_LENGTH];
+    char secondToken[MAXIMUM_TOKEN_LENGTH];
+    int firstLine = 1;
+    int secondLine = 1;
+    int tokensCount = 0;
+    int mismatchesCount = 0;
+
+    while (true) {
+        bool firstRead = readToken(firstFile, firstToken, &firstLine);
+        bool secondRead = readToken(secondFile, secondToken, &secondLine);
+
+        if (!firstRead || !secondRead) {
+            if (firstRead != secondRead) {
+                fprintf(stderr, "[compare] the dumps have different lengths\n");
+                mismatchesCount++;
+            }
+            break;
+        }
+
+        tokensCount++;
+
+        if (!tokensMatch(firstToken, secondToken)) {
+            if (mismatchesCount < 20) {
+                fprintf(stderr, "[compare] line %d: %s != %s\n", firstLine, firstToken, secondToken);
+            }
+            mismatchesCount++;
+        }
+    }
+
+    fclose(firstFile);
+    fclose(secondFile);
+
+    printf("[compare] %d tokens, %d mismatches\n", tokensCount, mismatchesCount);
+
+    return mismatchesCount == 0 ? 0 : 1;
+}
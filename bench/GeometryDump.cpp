@@ -0,0 +1,141 @@
+/*
+ * GeometryDump.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+/*
+ * Prints what the layout processing makes of generated layouts at every snapped globalOrientation: the rotated
+ * centroids, the slices along the rotated x axis and from the all-orientations table, and which panel a set of
+ * probe points falls in. Built once per geometry backend, the two dumps are compared by geometry_compare.
+ *
+ *   geometry_dump [panelsCount...]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "LayoutFixture.h"
+#include "LayoutGeometry.h"
+
+using namespace std;
+
+/* Constants */
+
+static const int DEFAULT_PANELS_COUNTS[] = {3, 50, 500};
+
+/*how far from the centroid towards each vertex the inner probes are, so they never sit on an edge*/
+static const double PROBE_VERTEX_RATIO = 0.8;
+
+/* Helpers */
+
+/**
+ * Internal helper: print a slice table, one slice per line
+ */
+static void dumpFrameSlices(const char* name, const FrameSliceTable* frameSlices) {
+    printf("%s %d\n", name, frameSlices->nFrameSlices);
+
+    for (int frameSliceIndex = 0; frameSliceIndex < frameSlices->nFrameSlices; frameSliceIndex++) {
+        const int* panelIds = frameSlices->getFrameSlicePanelIds(frameSliceIndex);
+        int frameSliceSize = frameSlices->getFrameSliceSize(frameSliceIndex);
+
+        printf("slice %d:", frameSliceIndex);
+
+        for (int index = 0; index < frameSliceSize; index++) {
+            printf(" %d", panelIds[index]);
+        }
+
+        printf("\n");
+    }
+}
+
+/**
+ * Internal helper: print the panel a point falls in, the point itself in layout units
+ */
+static void dumpProbe(const LayoutGeometry* geometry, double x, double y) {
+    printf(" %d", pointInsideWhichGeometryPanel(geometry, coordFromLength(x), coordFromLength(y)));
+}
+
+/**
+ * Internal helper: print everything the plugin derives from one layout rotated through one snapped angle
+ */
+static void dumpRotatedGeometry(LayoutGeometry* geometry, const FrameSliceTable* allOrientationsSlices, int orientationIndex) {
+    int angle = orientationIndex * SNAPPED_ORIENTATION_STEP;
+    rotateLayoutGeometry(geometry, &angle);
+
+    printf("rotation %d\n", geometry->totalRotation);
+
+    for (int panelIndex = 0; panelIndex < geometry->nPanels; panelIndex++) {
+        Vec2 centroid = geometry->centroids.get(panelIndex);
+        printf("centroid %d %.4f %.4f\n", geometry->panelIds[panelIndex], coordToLength(centroid.x), coordToLength(centroid.y));
+    }
+
+    FrameSliceTable frameSlices;
+    getFrameSlicesFromGeometry(geometry, 0, getFrameSliceWidth(geometry, 0), &frameSlices);
+    dumpFrameSlices("slices", &frameSlices);
+    dumpFrameSlices("table", &allOrientationsSlices[orientationIndex]);
+
+    for (int panelIndex = 0; panelIndex < geometry->nPanels; panelIndex++) {
+        Vec2 centroid = geometry->centroids.get(panelIndex);
+        double centroidX = coordToLength(centroid.x);
+        double centroidY = coordToLength(centroid.y);
+
+        printf("probes %d:", geometry->panelIds[panelIndex]);
+        dumpProbe(geometry, centroidX, centroidY);
+
+        for (int vertexIndex = geometry->vertexOffsets[panelIndex]; vertexIndex < geometry->vertexOffsets[panelIndex + 1]; vertexIndex++) {
+            Vec2 vertex = geometry->vertices.get(vertexIndex);
+            dumpProbe(geometry,
+                      centroidX + (coordToLength(vertex.x) - centroidX) * PROBE_VERTEX_RATIO,
+                      centroidY + (coordToLength(vertex.y) - centroidY) * PROBE_VERTEX_RATIO);
+        }
+
+        printf("\n");
+    }
+
+    printf("outside");
+    dumpProbe(geometry, -1e6, -1e6);
+    printf("\n");
+}
+
+/* Main */
+
+int main(int argc, char** argv) {
+    vector<int> panelsCounts;
+
+    for (int argumentIndex = 1; argumentIndex < argc; argumentIndex++) {
+        panelsCounts.push_back(atoi(argv[argumentIndex]));
+    }
+
+    if (panelsCounts.empty()) {
+        panelsCounts.assign(DEFAULT_PANELS_COUNTS, DEFAULT_PANELS_COUNTS + sizeof(DEFAULT_PANELS_COUNTS) / sizeof(int));
+    }
+
+    const int shapeTypes[] = {SHAPE_TRIANGLE, SHAPE_SQUARE};
+    const int layoutShapes[] = {GENERATED_LAYOUT_BLOB, GENERATED_LAYOUT_COLUMN, GENERATED_LAYOUT_ROW};
+
+    for (int shapeType : shapeTypes) {
+        for (int layoutShape : layoutShapes) {
+            for (int nPanels : panelsCounts) {
+                printf("layout %d %d %d\n", shapeType, layoutShape, nPanels);
+
+                FrameSliceTable allOrientationsSlices[SNAPPED_ORIENTATIONS_COUNT];
+
+                {
+                    LayoutGeometry geometry;
+                    generateLayoutGeometry(&geometry, nPanels, shapeType, layoutShape, layoutShape == GENERATED_LAYOUT_BLOB);
+                    getFrameSlicesForAllOrientations(&geometry, allOrientationsSlices);
+                }
+
+                for (int orientationIndex = 0; orientationIndex < SNAPPED_ORIENTATIONS_COUNT; orientationIndex++) {
+                    LayoutGeometry geometry;
+                    generateLayoutGeometry(&geometry, nPanels, shapeType, layoutShape, layoutShape == GENERATED_LAYOUT_BLOB);
+                    dumpRotatedGeometry(&geometry, allOrientationsSlices, orientationIndex);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,290 @@
+/*
+ * LayoutFixture.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "LayoutFixture.h"
+
+using namespace std;
+
+/* Constants */
+
+static const double TRIANGLE_HEIGHT_RATIO = 0.86602540378443864676; // sqrt(3) / 2
+
+static const double RHYTHM_WIDTH_RATIO = 0.25;
+static const double RHYTHM_HEIGHT_RATIO = 0.125;
+
+// An odd multiplier is a bijection on 31 bits, so the generated ids are unique and scattered like real ones.
+static const uint32_t PANEL_ID_MULTIPLIER = 2654435761u;
+
+/* Helpers */
+
+struct LatticeCell {
+    int row;
+    int column;
+    double distance;
+};
+
+static int generatedPanelId(int panelIndex) {
+    return (int)(((uint32_t)(panelIndex + 1) * PANEL_ID_MULTIPLIER) & 0x7FFFFFFF);
+}
+
+static bool isUpTriangle(int row, int column) {
+    return ((row + column) & 1) == 0;
+}
+
+static void getCellCentroid(int shapeType, int row, int column, double* x, double* y) {
+    double side = Shape::sideLength;
+
+    if (shapeType == SHAPE_SQUARE) {
+        *x = column * side;
+        *y = row * side;
+    } else {
+        double height = side * TRIANGLE_HEIGHT_RATIO;
+
+        *x = column * side / 2;
+        *y = row * height + (isUpTriangle(row, column) ? height / 3 : 2 * height / 3);
+    }
+}
+
+static vector<LatticeCell> getLayoutCells(int nPanels, int shapeType, int layoutShape) {
+    vector<LatticeCell> cells;
+    cells.reserve(nPanels);
+
+    if (layoutShape == GENERATED_LAYOUT_ROW) {
+        for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+            cells.push_back({0, panelIndex, 0});
+        }
+    } else if (layoutShape == GENERATED_LAYOUT_COLUMN) {
+        // Triangles need two per row to stay connected, one up and one down.
+        int cellsPerRow = shapeType == SHAPE_SQUARE ? 1 : 2;
+
+        for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+            cells.push_back({panelIndex / cellsPerRow, panelIndex % cellsPerRow, 0});
+        }
+    } else {
+        // Enough candidates around the origin for twice the needed area, then keep the closest ones.
+        double cellArea = shapeType == SHAPE_SQUARE ? 1.0 : TRIANGLE_HEIGHT_RATIO / 2;
+        double rowHeight = shapeType == SHAPE_SQUARE ? 1.0 : TRIANGLE_HEIGHT_RATIO;
+        double columnWidth = shapeType == SHAPE_SQUARE ? 1.0 : 0.5;
+        double radius = sqrt(2 * nPanels * cellArea / M_PI) + 1;
+
+        int rowsRadius = (int)ceil(radius / rowHeight);
+        int columnsRadius = (int)ceil(radius / columnWidth);
+
+        vector<LatticeCell> candidates;
+        candidates.reserve((2 * rowsRadius + 1) * (2 * columnsRadius + 1));
+
+        for (int row = -rowsRadius; row <= rowsRadius; row++) {
+            for (int column = -columnsRadius; column <= columnsRadius; column++) {
+                double x;
+                double y;
+                getCellCentroid(shapeType, row, column, &x, &y);
+
+                candidates.push_back({row, column, x * x + y * y});
+            }
+        }
+
+        auto closer = [](const LatticeCell& first, const LatticeCell& second) -> bool {
+            if (first.distance != second.distance) {
+                return first.distance < second.distance;
+            }
+            return first.row != second.row ? first.row < second.row : first.column < second.column;
+        };
+
+        int keptCount = min(nPanels, (int)candidates.size());
+
+        partial_sort(candidates.begin(), candidates.begin() + keptCount, candidates.end(), closer);
+
+        cells.assign(candidates.begin(), candidates.begin() + keptCount);
+    }
+
+    return cells;
+}
+
+/* API */
+
+void generateLayoutGeometry(LayoutGeometry* geometry, int nPanels, int shapeType, int layoutShape, bool withRhythm) {
+    vector<LatticeCell> cells = getLayoutCells(nPanels, shapeType, layoutShape);
+
+    int nLitPanels = cells.size();
+    int nVerticesPerPanel = shapeType == SHAPE_SQUARE ? 4 : 3;
+    int nAllPanels = nLitPanels + (withRhythm ? 1 : 0);
+    int nVertices = nLitPanels * nVerticesPerPanel + (withRhythm ? 4 : 0);
+
+    allocateLayoutGeometry(geometry, nAllPanels, nVertices);
+
+    double side = Shape::sideLength;
+    double height = side * TRIANGLE_HEIGHT_RATIO;
+
+    int vertexIndex = 0;
+
+    for (int panelIndex = 0; panelIndex < nLitPanels; panelIndex++) {
+        const LatticeCell& cell = cells[panelIndex];
+
+        double x;
+        double y;
+        getCellCentroid(shapeType, cell.row, cell.column, &x, &y);
+
+        double vertexXs[4];
+        double vertexYs[4];
+        int orientation = 0;
+
+        if (shapeType == SHAPE_SQUARE) {
+            vertexXs[0] = x - side / 2; vertexYs[0] = y - side / 2;
+            vertexXs[1] = x + side / 2; vertexYs[1] = y - side / 2;
+            vertexXs[2] = x + side / 2; vertexYs[2] = y + side / 2;
+            vertexXs[3] = x - side / 2; vertexYs[3] = y + side / 2;
+        } else if (isUpTriangle(cell.row, cell.column)) {
+            vertexXs[0] = x - side / 2; vertexYs[0] = y - height / 3;
+            vertexXs[1] = x + side / 2; vertexYs[1] = y - height / 3;
+            vertexXs[2] = x;            vertexYs[2] = y + 2 * height / 3;
+        } else {
+            vertexXs[0] = x + side / 2; vertexYs[0] = y + height / 3;
+            vertexXs[1] = x - side / 2; vertexYs[1] = y + height / 3;
+            vertexXs[2] = x;            vertexYs[2] = y - 2 * height / 3;
+
+            orientation = 60;
+        }
+
+        geometry->panelIds[panelIndex] = generatedPanelId(panelIndex);
+        geometry->shapeTypes[panelIndex] = shapeType;
+        geometry->orientations[panelIndex] = orientation;
+        geometry->centroids.x[panelIndex] = coordFromLength(x);
+        geometry->centroids.y[panelIndex] = coordFromLength(y);
+        geometry->vertexOffsets[panelIndex] = vertexIndex;
+
+        for (int shapeVertexIndex = 0; shapeVertexIndex < nVerticesPerPanel; shapeVertexIndex++) {
+            geometry->vertices.x[vertexIndex] = coordFromLength(vertexXs[shapeVertexIndex]);
+            geometry->vertices.y[vertexIndex] = coordFromLength(vertexYs[shapeVertexIndex]);
+
+            vertexIndex++;
+        }
+    }
+
+    if (withRhythm) {
+        // A small module clipped to the right of the right-most panel, so that it never overlaps another one.
+        int anchorPanelIndex = 0;
+
+        for (int panelIndex = 1; panelIndex < nLitPanels; panelIndex++) {
+            if (geometry->centroids.x[panelIndex] > geometry->centroids.x[anchorPanelIndex]) {
+                anchorPanelIndex = panelIndex;
+            }
+        }
+
+        double x = coordToLength(geometry->centroids.x[anchorPanelIndex]) + side * (0.5 + RHYTHM_WIDTH_RATIO / 2);
+        double y = coordToLength(geometry->centroids.y[anchorPanelIndex]);
+        double halfWidth = side * RHYTHM_WIDTH_RATIO / 2;
+        double halfHeight = side * RHYTHM_HEIGHT_RATIO / 2;
+
+        geometry->panelIds[nLitPanels] = generatedPanelId(nLitPanels);
+        geometry->shapeTypes[nLitPanels] = SHAPE_RHYTHM;
+        geometry->orientations[nLitPanels] = 0;
+        geometry->centroids.x[nLitPanels] = coordFromLength(x);
+        geometry->centroids.y[nLitPanels] = coordFromLength(y);
+        geometry->vertexOffsets[nLitPanels] = vertexIndex;
+
+        double vertexXs[4] = {x - halfWidth, x + halfWidth, x + halfWidth, x - halfWidth};
+        double vertexYs[4] = {y - halfHeight, y - halfHeight, y + halfHeight, y + halfHeight};
+
+        for (int shapeVertexIndex = 0; shapeVertexIndex < 4; shapeVertexIndex++) {
+            geometry->vertices.x[vertexIndex] = coordFromLength(vertexXs[shapeVertexIndex]);
+            geometry->vertices.y[vertexIndex] = coordFromLength(vertexYs[shapeVertexIndex]);
+
+            vertexIndex++;
+        }
+    }
+
+    geometry->vertexOffsets[nAllPanels] = vertexIndex;
+}
+
+bool writeLayoutFixture(const LayoutGeometry* geometry, int globalOrientation, const char* path) {
+    FILE* file = fopen(path, "wb");
+
+    if (!file) {
+        return false;
+    }
+
+    int nVertices = geometry->vertexOffsets[geometry->nPanels];
+
+    LayoutFixtureHeader header;
+    header.magic = LAYOUT_FIXTURE_MAGIC;
+    header.version = LAYOUT_FIXTURE_VERSION;
+    header.coordinateFormat = LAYOUT_FIXTURE_COORDINATE_FORMAT;
+    header.nPanels = geometry->nPanels;
+    header.nVertices = nVertices;
+    header.globalOrientation = globalOrientation;
+    header.totalRotation = geometry->totalRotation;
+    header.reserved = 0;
+
+    size_t arenaSize = getLayoutGeometryArenaSize(geometry->nPanels, nVertices);
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(geometry->arena, 1, arenaSize, file) == arenaSize;
+
+    return fclose(file) == 0 && written;
+}
+
+bool loadLayoutFixture(LayoutGeometry* geometry, int* globalOrientation, const char* path) {
+    freeLayoutGeometry(geometry);
+
+    int file = open(path, O_RDONLY);
+
+    if (file < 0) {
+        return false;
+    }
+
+    struct stat status;
+
+    if (fstat(file, &status) != 0 || (size_t)status.st_size < sizeof(LayoutFixtureHeader)) {
+        close(file);
+        return false;
+    }
+
+    void* mapping = mmap(NULL, status.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+
+    close(file);
+
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    const LayoutFixtureHeader* header = (const LayoutFixtureHeader*)mapping;
+
+    bool isValid = header->magic == LAYOUT_FIXTURE_MAGIC &&
+                   header->version == LAYOUT_FIXTURE_VERSION &&
+                   header->coordinateFormat == LAYOUT_FIXTURE_COORDINATE_FORMAT &&
+                   header->nPanels >= 0 && header->nVertices >= 0 &&
+                   sizeof(*header) + getLayoutGeometryArenaSize(header->nPanels, header->nVertices) <= (size_t)status.st_size;
+
+    if (!isValid) {
+        munmap(mapping, status.st_size);
+        return false;
+    }
+
+    char* arena = (char*)mapping + sizeof(*header);
+
+    carveLayoutGeometry(geometry, arena, header->nPanels, header->nVertices);
+
+    geometry->arena = arena;
+    geometry->mapping = mapping;
+    geometry->mappingSize = status.st_size;
+    geometry->totalRotation = header->totalRotation;
+
+    if (globalOrientation) {
+        *globalOrientation = header->globalOrientation;
+    }
+
+    return true;
+}
@@ -0,0 +1,79 @@
+/*
+ * LayoutFixture.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef BENCH_LAYOUTFIXTURE_H_
+#define BENCH_LAYOUTFIXTURE_H_
+
+#include <stdint.h>
+
+#include "LayoutGeometry.h"
+
+/*
+ * Fixture layout, in the byte order of the machine that wrote it:
+ *
+ *   LayoutFixtureHeader
+ *   the arena of a LayoutGeometry, exactly as carveLayoutGeometry lays it out
+ *
+ * so that loading a fixture is mapping the file and pointing the geometry arrays into it.
+ * The coordinates are stored as coord_t, a fixture can only be loaded by a build using the same backend.
+ */
+
+#define LAYOUT_FIXTURE_MAGIC 0x464C4C4E			/*"NLLF"*/
+#define LAYOUT_FIXTURE_VERSION 1
+
+#ifdef FIXED_POINT_GEOMETRY
+#define LAYOUT_FIXTURE_COORDINATE_FORMAT 1		/*Q16.16 in units of Shape::sideLength*/
+#else
+#define LAYOUT_FIXTURE_COORDINATE_FORMAT 0		/*double in layout units*/
+#endif
+
+/**
+ * What the generated panels are arranged into
+ */
+enum GeneratedLayoutShape {
+	GENERATED_LAYOUT_BLOB = 0,			/*the panels closest to the origin, roughly a disc*/
+	GENERATED_LAYOUT_COLUMN,			/*a single long vertical strip*/
+	GENERATED_LAYOUT_ROW				/*a single long horizontal strip*/
+};
+
+struct LayoutFixtureHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t coordinateFormat;			/*LAYOUT_FIXTURE_COORDINATE_FORMAT of the build that wrote it*/
+	int32_t nPanels;
+	int32_t nVertices;
+	int32_t globalOrientation;			/*the orientation as set by the user, to be passed to rotateLayoutGeometry*/
+	int32_t totalRotation;				/*the rotation already applied to the stored geometry*/
+	uint32_t reserved;
+};
+
+/**
+ * @description: generate a connected layout, with the same conventions as the layouts of the controller
+ * @params geometry: the geometry to fill, any previous content is released
+ * @params nPanels: number of lit panels, from 3 to 100000 and more
+ * @params shapeType: SHAPE_TRIANGLE or SHAPE_SQUARE
+ * @params layoutShape: one of GeneratedLayoutShape
+ * @params withRhythm: whether to attach a SHAPE_RHYTHM module to the right-most panel, on top of the lit ones
+ */
+void generateLayoutGeometry(LayoutGeometry* geometry, int nPanels, int shapeType, int layoutShape, bool withRhythm);
+
+/**
+ * @description: save a geometry as a fixture
+ * @params globalOrientation: stored with the geometry, as the user orientation of the layout
+ * @return: true on success
+ */
+bool writeLayoutFixture(const LayoutGeometry* geometry, int globalOrientation, const char* path);
+
+/**
+ * @description: map a fixture into a geometry, without copying it. The mapping is private, so rotating the
+ * geometry only copies the pages it touches and never writes to the file
+ * @params geometry: the geometry to fill, any previous content is released
+ * @params globalOrientation: filled with the stored orientation, may be NULL
+ * @return: true on success, false if the file cannot be mapped, is not a fixture, or uses another coordinate format
+ */
+bool loadLayoutFixture(LayoutGeometry* geometry, int* globalOrientation, const char* path);
+
+#endif /* BENCH_LAYOUTFIXTURE_H_ */
@@ -0,0 +1,23 @@
+/*
+ * SdkStubs.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+/*
+ * The few symbols of libPluginUtilities that the layout processing links against, so that it can be built and
+ * measured on the host. The library itself only ships for the controller.
+ */
+
+#include "Shape.h"
+
+// The side length of the light panels, in layout units, as used by the SDK.
+int Shape::sideLength = 150;
+
+const Point& Shape::getCentroid() const {
+    return centroid;
+}
+
+int Shape::getOrientation() const {
+    return orientation;
+}
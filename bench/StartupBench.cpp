@@ -0,0 +1,169 @@
+/*
+ * StartupBench.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+/*
+ * Times the layout processing of initPlugin on generated layouts: every shape, from a handful of panels to 100000,
+ * compact and pathological, at every snapped globalOrientation. Each layout goes through a fixture file, mapped
+ * back the way a recorded layout would be, then sliced for all orientations, linked into the adjacency graph and
+ * rotated to its orientation.
+ *
+ *   startup_bench [fixtureDirectory] [panelsCount...]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+#include "LayoutFixture.h"
+#include "LayoutGeometry.h"
+#include "PanelAdjacency.h"
+#include "MonotonicClock.h"
+
+using namespace std;
+
+/* Constants */
+
+static const int DEFAULT_PANELS_COUNTS[] = {3, 100, 1000, 10000, 100000};
+
+enum StartupPhase {
+    STARTUP_PHASE_LOAD = 0,
+    STARTUP_PHASE_SLICE,
+    STARTUP_PHASE_ADJACENCY,
+    STARTUP_PHASE_ROTATE,
+    STARTUP_PHASE_TOTAL,
+    STARTUP_PHASES_COUNT
+};
+
+static const char* STARTUP_PHASE_NAMES[STARTUP_PHASES_COUNT] = {
+    "load",
+    "slice",
+    "adjacency",
+    "rotate",
+    "total"
+};
+
+#ifdef FIXED_POINT_GEOMETRY
+static const char* GEOMETRY_BACKEND_NAME = "Q16.16";
+#else
+static const char* GEOMETRY_BACKEND_NAME = "double";
+#endif
+
+/* Helpers */
+
+static const char* getShapeName(int shapeType) {
+    return shapeType == SHAPE_SQUARE ? "square" : "triangle";
+}
+
+static const char* getLayoutShapeName(int layoutShape) {
+    switch (layoutShape) {
+        case GENERATED_LAYOUT_COLUMN:
+            return "column";
+        case GENERATED_LAYOUT_ROW:
+            return "row";
+        default:
+            return "blob+rhythm";
+    }
+}
+
+/**
+ * Internal helper: run the startup of one fixture and time every phase
+ * @return: false if the fixture cannot be loaded
+ */
+static bool timeStartup(const char* path, uint64_t* durations) {
+    LayoutGeometry geometry;
+    PanelAdjacency adjacency;
+    FrameSliceTable frameSlices[SNAPPED_ORIENTATIONS_COUNT];
+    int globalOrientation;
+
+    uint64_t startTime = monotonicNanoseconds();
+
+    if (!loadLayoutFixture(&geometry, &globalOrientation, path)) {
+        return false;
+    }
+
+    uint64_t loadedTime = monotonicNanoseconds();
+    getFrameSlicesForAllOrientations(&geometry, frameSlices);
+
+    uint64_t slicedTime = monotonicNanoseconds();
+    buildPanelAdjacency(&geometry, &adjacency);
+
+    uint64_t linkedTime = monotonicNanoseconds();
+    rotateLayoutGeometry(&geometry, &globalOrientation);
+
+    uint64_t rotatedTime = monotonicNanoseconds();
+
+    durations[STARTUP_PHASE_LOAD] = loadedTime - startTime;
+    durations[STARTUP_PHASE_SLICE] = slicedTime - loadedTime;
+    durations[STARTUP_PHASE_ADJACENCY] = linkedTime - slicedTime;
+    durations[STARTUP_PHASE_ROTATE] = rotatedTime - linkedTime;
+    durations[STARTUP_PHASE_TOTAL] = rotatedTime - startTime;
+
+    return true;
+}
+
+/* Main */
+
+int main(int argc, char** argv) {
+    const char* fixtureDirectory = argc > 1 ? argv[1] : "/tmp";
+
+    vector<int> panelsCounts;
+
+    for (int argumentIndex = 2; argumentIndex < argc; argumentIndex++) {
+        panelsCounts.push_back(atoi(argv[argumentIndex]));
+    }
+
+    if (panelsCounts.empty()) {
+        panelsCounts.assign(DEFAULT_PANELS_COUNTS, DEFAULT_PANELS_COUNTS + sizeof(DEFAULT_PANELS_COUNTS) / sizeof(int));
+    }
+
+    char path[1024];
+    snprintf(path, sizeof(path), "%s/startup_bench.fixture", fixtureDirectory);
+
+    const int shapeTypes[] = {SHAPE_TRIANGLE, SHAPE_SQUARE};
+    const int layoutShapes[] = {GENERATED_LAYOUT_BLOB, GENERATED_LAYOUT_COLUMN, GENERATED_LAYOUT_ROW};
+
+    printf("[startup] %s geometry, median over the %d snapped orientations, in microseconds\n", GEOMETRY_BACKEND_NAME, SNAPPED_ORIENTATIONS_COUNT);
+
+    for (int shapeType : shapeTypes) {
+        for (int layoutShape : layoutShapes) {
+            for (int nPanels : panelsCounts) {
+                LayoutGeometry geometry;
+                generateLayoutGeometry(&geometry, nPanels, shapeType, layoutShape, layoutShape == GENERATED_LAYOUT_BLOB);
+
+                vector<uint64_t> samples[STARTUP_PHASES_COUNT];
+
+                for (int orientationIndex = 0; orientationIndex < SNAPPED_ORIENTATIONS_COUNT; orientationIndex++) {
+                    uint64_t durations[STARTUP_PHASES_COUNT];
+
+                    if (!writeLayoutFixture(&geometry, orientationIndex * SNAPPED_ORIENTATION_STEP, path) || !timeStartup(path, durations)) {
+                        fprintf(stderr, "[startup] cannot go through %s\n", path);
+                        return 1;
+                    }
+
+                    for (int phase = 0; phase < STARTUP_PHASES_COUNT; phase++) {
+                        samples[phase].push_back(durations[phase]);
+                    }
+                }
+
+                printf("[startup] %-8s %-11s %6d panels:", getShapeName(shapeType), getLayoutShapeName(layoutShape), nPanels);
+
+                for (int phase = 0; phase < STARTUP_PHASES_COUNT; phase++) {
+                    vector<uint64_t>& phaseSamples = samples[phase];
+                    nth_element(phaseSamples.begin(), phaseSamples.begin() + phaseSamples.size() / 2, phaseSamples.end());
+
+                    printf(" %s %llu", STARTUP_PHASE_NAMES[phase], (unsigned long long)(phaseSamples[phaseSamples.size() / 2] / 1000));
+                }
+
+                printf("\n");
+            }
+        }
+    }
+
+    remove(path);
+
+    return 0;
+}
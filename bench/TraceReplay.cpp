@@ -0,0 +1,69 @@
+/*
+ * TraceReplay.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+/*
+ * Streams a trace recorded with FRAME_RECORDING_ENABLED back as text, one line per getPluginFrame call, so that
+ * the output of two builds of the plugin can be diffed. The replay speed and volume go to stderr.
+ *
+ *   trace_replay [tracePath] [--real-time]
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FrameTraceReplay.h"
+#include "MonotonicClock.h"
+
+/* Helpers */
+
+struct ReplayStatistics {
+    int recordsCount;
+    long long framesCount;
+};
+
+static void printRecord(void* context, const Frame_t* frames, int nFrames, int sleepTime) {
+    ReplayStatistics* statistics = (ReplayStatistics*)context;
+
+    printf("call %d n=%d sleep=%d:", statistics->recordsCount, nFrames, sleepTime);
+
+    for (int index = 0; index < nFrames; index++) {
+        printf(" [%d %d,%d,%d t%d]", frames[index].panelId, frames[index].r, frames[index].g, frames[index].b, frames[index].transTime);
+    }
+
+    printf("\n");
+
+    statistics->recordsCount++;
+    statistics->framesCount += nFrames;
+}
+
+/* Main */
+
+int main(int argc, char** argv) {
+    const char* path = FRAME_TRACE_PATH;
+    bool realTime = false;
+
+    for (int argumentIndex = 1; argumentIndex < argc; argumentIndex++) {
+        if (strcmp(argv[argumentIndex], "--real-time") == 0) {
+            realTime = true;
+        } else {
+            path = argv[argumentIndex];
+        }
+    }
+
+    ReplayStatistics statistics = {0, 0};
+    uint64_t startTime = monotonicNanoseconds();
+
+    if (replayFrameTrace(path, printRecord, &statistics, realTime) < 0) {
+        fprintf(stderr, "[replay] cannot open %s\n", path);
+        return 1;
+    }
+
+    uint64_t elapsed = monotonicNanoseconds() - startTime;
+
+    fprintf(stderr, "[replay] %d records, %lld frames in %llu us\n", statistics.recordsCount, statistics.framesCount, (unsigned long long)(elapsed / 1000));
+
+    return 0;
+}
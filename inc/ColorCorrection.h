@@ -0,0 +1,44 @@
+/*
+ * ColorCorrection.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_COLORCORRECTION_H_
+#define INC_COLORCORRECTION_H_
+
+#include <stdint.h>
+
+#define COLOR_LEVELS_COUNT 256
+#define DITHER_PHASES_COUNT 16			/*frames it takes the temporal dither to go through all its thresholds*/
+
+/**
+ * Turns the composed frame into the levels sent to the panels: brightness, then gamma, then dithering,
+ * all folded into a single table lookup per channel
+ */
+struct ColorCorrection {
+	uint16_t levels[COLOR_LEVELS_COUNT];	/*the output level of every input level, in 8.8 fixed point*/
+	bool dither;							/*spread the fraction of the levels over successive frames instead of rounding it*/
+	bool identity;							/*true when the levels change nothing, the pass is then skipped*/
+	uint32_t frameCounter;					/*the dithered frames corrected so far, drives the dither*/
+};
+
+/**
+ * @description: build the table once, whenever the options change
+ * @params brightness: in percent, applied before the gamma so that dimming looks even
+ * @params gammaCorrection: whether to map the levels through a 2.2 gamma curve
+ * @params dither: whether to dither the levels in time
+ */
+void initColorCorrection(ColorCorrection* correction, int brightness, bool gammaCorrection, bool dither);
+
+/**
+ * @description: correct every channel of a frame in place, in one pass
+ * @params channels: nPanels * FRAME_CHANNELS_COUNT values, as in FrameCompositor.output
+ * @params nPanels: number of panels
+ * @params frequentFrames: whether the next frame follows within a fraction of a second. The dither only blends
+ * into the in-between level over such frames, slower ones are rounded instead, which also keeps them unchanged
+ * for the delta filter
+ */
+void applyColorCorrection(ColorCorrection* correction, uint8_t* channels, int nPanels, bool frequentFrames);
+
+#endif /* INC_COLORCORRECTION_H_ */
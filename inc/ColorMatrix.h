@@ -0,0 +1,62 @@
+/*
+ * ColorMatrix.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_COLORMATRIX_H_
+#define INC_COLORMATRIX_H_
+
+#include <stdint.h>
+
+#define COLOR_MATRIX_FRACTION_BITS 12
+#define COLOR_MATRIX_ONE (1 << COLOR_MATRIX_FRACTION_BITS)
+#define COLOR_MATRIX_SIZE 3
+
+enum ColorVision {
+	COLOR_VISION_NORMAL = 0,
+	COLOR_VISION_PROTAN,		/*red-blind*/
+	COLOR_VISION_DEUTAN,		/*green-blind*/
+	COLOR_VISION_TRITAN,		/*blue-blind*/
+	COLOR_VISIONS_COUNT
+};
+
+/**
+ * An affine transform of the RGB channels, out = coefficients * in + offsets, in fixed point.
+ * Several transforms are multiplied together once, so the frame only ever goes through one of them
+ */
+struct ColorMatrix {
+	int32_t coefficients[COLOR_MATRIX_SIZE * COLOR_MATRIX_SIZE];	/*row major, in COLOR_MATRIX_ONE units*/
+	int32_t offsets[COLOR_MATRIX_SIZE];								/*added to each output channel, in levels times COLOR_MATRIX_ONE*/
+	bool identity;													/*true when the transform changes nothing, the pass is then skipped*/
+};
+
+/**
+ * @description: reset a matrix to the transform that changes nothing
+ */
+void setColorMatrixIdentity(ColorMatrix* matrix);
+
+/**
+ * @description: combine two transforms into one
+ * @params first: the transform applied first
+ * @params then: the transform applied to the result of first
+ * @params product: filled with the combined transform, may be first or then
+ */
+void multiplyColorMatrices(const ColorMatrix* first, const ColorMatrix* then, ColorMatrix* product);
+
+/**
+ * @description: bake the transform for the options, once whenever they change. The color vision variant shifts
+ * the colors a viewer cannot tell apart into channels they can see, then the white balance scales each channel
+ * @params colorVision: one of ColorVision
+ * @params whiteRed, whiteGreen, whiteBlue: the gain of each channel, in percent
+ */
+void initColorMatrix(ColorMatrix* matrix, int colorVision, int whiteRed, int whiteGreen, int whiteBlue);
+
+/**
+ * @description: transform every color of a frame in place, in one pass
+ * @params channels: nPanels * FRAME_CHANNELS_COUNT values, as in FrameCompositor.output
+ * @params nPanels: number of panels
+ */
+void applyColorMatrix(const ColorMatrix* matrix, uint8_t* channels, int nPanels);
+
+#endif /* INC_COLORMATRIX_H_ */
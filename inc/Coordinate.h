@@ -0,0 +1,122 @@
+/*
+ * Coordinate.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_COORDINATE_H_
+#define INC_COORDINATE_H_
+
+#include <stdint.h>
+#include <math.h>
+
+#include "Shape.h"
+#include "IntegerMath.h"
+
+//#define FIXED_POINT_GEOMETRY
+
+#ifdef FIXED_POINT_GEOMETRY
+
+/*
+ * Q16.16 fixed point, in units of Shape::sideLength.
+ * Meant for controllers without an FPU, where every double operation goes through soft-float.
+ */
+typedef int32_t coord_t;
+
+#define COORD_FRACTION_BITS 16
+#define COORD_ONE (1 << COORD_FRACTION_BITS)
+
+/**
+ * @description: convert a dimensionless constant, e.g. a sine
+ */
+#define COORD_FROM_RATIO(ratio) ((coord_t)((ratio) * COORD_ONE + ((ratio) < 0 ? -0.5 : 0.5)))
+
+/**
+ * @description: convert a constant expressed in side lengths, e.g. 0.5 for half a side
+ */
+#define COORD_FROM_SIDE_LENGTHS(sideLengths) COORD_FROM_RATIO(sideLengths)
+
+/**
+ * @description: convert a length in layout units, as used by Point, to a coordinate
+ */
+inline coord_t coordFromLength(double length) {
+	return (coord_t)lround(length * COORD_ONE / Shape::sideLength);
+}
+
+/**
+ * @description: convert a coordinate back to a length in layout units
+ */
+inline double coordToLength(coord_t coord) {
+	return (double)coord * Shape::sideLength / COORD_ONE;
+}
+
+/**
+ * @description: compute a * b + c * d with a single rounding step
+ */
+inline coord_t coordMultiplyAdd(coord_t a, coord_t b, coord_t c, coord_t d) {
+	return (coord_t)(((int64_t)a * b + (int64_t)c * d + (1 << (COORD_FRACTION_BITS - 1))) >> COORD_FRACTION_BITS);
+}
+
+/**
+ * @description: compute the sign of the cross product a * b - c * d without overflowing
+ */
+inline int coordCrossSign(coord_t a, coord_t b, coord_t c, coord_t d) {
+	int64_t cross = (int64_t)a * b - (int64_t)c * d;
+
+	return (cross > 0) - (cross < 0);
+}
+
+/**
+ * @description: divide a non-negative numerator by a positive denominator, rounding to the closest integer
+ */
+inline int coordDivideRounded(coord_t numerator, coord_t denominator) {
+	return (numerator + denominator / 2) / denominator;
+}
+
+/**
+ * @description: compute the length of the vector (dx, dy). The square root of a Q32.32 value is a Q16.16 one,
+ * so a bitwise integer square root of the 64 bit sum of squares is all that is needed
+ */
+inline coord_t coordHypot(coord_t dx, coord_t dy) {
+	return (coord_t)integerSquareRoot((uint64_t)((int64_t)dx * dx) + (uint64_t)((int64_t)dy * dy));
+}
+
+#else
+
+/*
+ * Plain double precision, in layout units.
+ */
+typedef double coord_t;
+
+#define COORD_FROM_RATIO(ratio) ((coord_t)(ratio))
+#define COORD_FROM_SIDE_LENGTHS(sideLengths) ((coord_t)(sideLengths) * Shape::sideLength)
+
+inline coord_t coordFromLength(double length) {
+	return length;
+}
+
+inline double coordToLength(coord_t coord) {
+	return coord;
+}
+
+inline coord_t coordMultiplyAdd(coord_t a, coord_t b, coord_t c, coord_t d) {
+	return a * b + c * d;
+}
+
+inline int coordCrossSign(coord_t a, coord_t b, coord_t c, coord_t d) {
+	double cross = a * b - c * d;
+
+	return (cross > 0) - (cross < 0);
+}
+
+inline int coordDivideRounded(coord_t numerator, coord_t denominator) {
+	return (int)floor(numerator / denominator + 0.5);
+}
+
+inline coord_t coordHypot(coord_t dx, coord_t dy) {
+	return sqrt(dx * dx + dy * dy);
+}
+
+#endif
+
+#endif /* INC_COORDINATE_H_ */
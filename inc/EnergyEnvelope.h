@@ -0,0 +1,46 @@
+/*
+ * EnergyEnvelope.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_ENERGYENVELOPE_H_
+#define INC_ENERGYENVELOPE_H_
+
+#include <stdint.h>
+
+#define ENVELOPE_FRACTION_BITS 16
+#define ENVELOPE_ONE (1 << ENVELOPE_FRACTION_BITS)
+#define ENVELOPE_LEVELS_COUNT 256
+#define ENVELOPE_STEP_NANOSECONDS 50000000	/*the sound call interval the rates are given for*/
+
+/**
+ * Follows the sound energy with a fast attack and a slow release, and scales it against a slowly decaying peak
+ * so that quiet and loud venues both drive the full range. It advances in steps of the sound call interval, however
+ * far apart the calls actually are. All in integer fixed point, nothing is allocated
+ */
+struct EnergyEnvelope {
+	uint32_t envelope;			/*the smoothed energy, in ENVELOPE_ONE units*/
+	uint32_t peak;				/*the auto-gain reference, the loudest recent envelope, in ENVELOPE_ONE units*/
+	uint32_t attack;			/*the fraction of the gap closed per step when the energy rises, in ENVELOPE_ONE units*/
+	uint32_t release;			/*the fraction of the gap closed per step when the energy falls, in ENVELOPE_ONE units*/
+	uint64_t clockTime;			/*the time the envelope has been stepped up to, in nanoseconds*/
+};
+
+/**
+ * @description: reset the envelope to silence
+ * @params attack, release: the fraction of the gap to the energy closed per step, in percent, when it rises and falls
+ * @params now: the current time, in nanoseconds
+ */
+void initEnergyEnvelope(EnergyEnvelope* envelope, int attack, int release, uint64_t now);
+
+/**
+ * @description: feed the energy of one call and get the level it drives. The envelope takes as many steps as
+ * ENVELOPE_STEP_NANOSECONDS fit in the time since the previous call, the fraction is carried over to the next call
+ * @params energy: as returned by getEnergy
+ * @params now: the current time, in nanoseconds
+ * @return: the level, from 0 to ENVELOPE_LEVELS_COUNT - 1
+ */
+int followEnergyEnvelope(EnergyEnvelope* envelope, uint16_t energy, uint64_t now);
+
+#endif /* INC_ENERGYENVELOPE_H_ */
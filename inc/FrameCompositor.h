@@ -0,0 +1,97 @@
+/*
+ * FrameCompositor.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_FRAMECOMPOSITOR_H_
+#define INC_FRAMECOMPOSITOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "AuroraPlugin.h"
+#include "ColorUtils.h"
+
+#define MAXIMUM_FRAME_LAYERS_COUNT 8
+#define FRAME_CHANNELS_COUNT 3			/*r, g, b packed next to each other, panel after panel*/
+
+enum BlendMode {
+	BLEND_OVER = 0,						/*the layer replaces what is below, weighted by its alpha and opacity*/
+	BLEND_ADD,							/*the layer is added to what is below, saturating*/
+	BLEND_MULTIPLY,						/*what is below is scaled by the layer*/
+	BLEND_MAX							/*the brightest of the layer and what is below is kept, per channel*/
+};
+
+/**
+ * One full-frame image, in the frame order
+ */
+struct FrameLayer {
+	uint8_t* channels;					/*nPanels * FRAME_CHANNELS_COUNT values*/
+	uint8_t* alphas;					/*nPanels values, only used by BLEND_OVER, NULL for a fully opaque layer*/
+	int blendMode;						/*one of BlendMode*/
+	uint8_t opacity;					/*applied on top of the alphas, 255 is fully opaque*/
+	bool enabled;						/*disabled layers are skipped entirely*/
+};
+
+struct FrameCompositor {
+	int nPanels;						/*number of panels of every layer*/
+	uint8_t* output;					/*the composed frame, nPanels * FRAME_CHANNELS_COUNT values*/
+	FrameLayer layers[MAXIMUM_FRAME_LAYERS_COUNT];	/*composed bottom to top, over black*/
+	int nLayers;
+	FrameCompositor(const FrameCompositor&) = delete;
+	FrameCompositor(){
+		nPanels = 0;
+		output = NULL;
+		nLayers = 0;
+	}
+	~FrameCompositor(){
+		delete [] output;
+		for (int layerIndex = 0; layerIndex < nLayers; layerIndex++) {
+			delete [] layers[layerIndex].channels;
+			delete [] layers[layerIndex].alphas;
+		}
+	}
+};
+
+/**
+ * @description: allocate the output buffer, any previous layer is released
+ */
+void initFrameCompositor(FrameCompositor* compositor, int nPanels);
+
+/**
+ * @description: allocate a black, fully transparent layer on top of the existing ones. To be called at init only
+ * @params blendMode: one of BlendMode
+ * @params withAlphas: whether the layer needs per-panel alphas
+ * @return: the layer, NULL if MAXIMUM_FRAME_LAYERS_COUNT is reached
+ */
+FrameLayer* addFrameLayer(FrameCompositor* compositor, int blendMode, bool withAlphas);
+
+/**
+ * @description: set the color of one panel of a layer, and make it fully opaque if the layer has alphas
+ */
+void setFrameLayerColor(FrameLayer* layer, int frameIndex, const RGB_t& color);
+
+/**
+ * @description: reset a layer to black and, if it has alphas, fully transparent
+ */
+void clearFrameLayer(FrameLayer* layer, int nPanels);
+
+/**
+ * @description: blend all the enabled layers into the output buffer, with a fixed cost per layer per panel
+ */
+void composeFrame(FrameCompositor* compositor);
+
+/**
+ * @description: copy the output buffer into the frames, in one pass
+ * @params panelIds: the panelId at every frame index
+ * @params frames: the frames to fill
+ */
+void emitComposedFrame(const FrameCompositor* compositor, const int* panelIds, Frame_t* frames);
+
+/**
+ * @description: release the output buffer and the layers
+ */
+void freeFrameCompositor(FrameCompositor* compositor);
+
+#endif /* INC_FRAMECOMPOSITOR_H_ */
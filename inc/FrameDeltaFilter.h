@@ -0,0 +1,63 @@
+/*
+ * FrameDeltaFilter.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_FRAMEDELTAFILTER_H_
+#define INC_FRAMEDELTAFILTER_H_
+
+#include <stdint.h>
+
+#include "AuroraPlugin.h"
+
+/**
+ * Remembers what was last sent to every panel, so that only the panels that change are sent again.
+ * It relies on the frames always being generated in the same panel order
+ */
+struct FrameDeltaFilter {
+	int capacity;					/*number of elements of the arrays below*/
+	int nPanels;					/*number of panels of the last frame sent completely*/
+	int* panelIds;					/*the panelId last sent at each frame index*/
+	uint32_t* colors;				/*the color last sent at each frame index, packed as 0x00RRGGBB*/
+	bool valid;						/*false until a complete frame has been sent*/
+	FrameDeltaFilter(const FrameDeltaFilter&) = delete;
+	FrameDeltaFilter(){
+		capacity = 0;
+		nPanels = 0;
+		panelIds = NULL;
+		colors = NULL;
+		valid = false;
+	}
+	~FrameDeltaFilter(){
+		delete [] panelIds;
+		delete [] colors;
+	}
+};
+
+/**
+ * @description: allocate the filter for a layout, the next frame is always sent completely
+ * @params nPanels: the largest frame expected, larger ones make the arrays grow
+ */
+void initFrameDeltaFilter(FrameDeltaFilter* filter, int nPanels);
+
+/**
+ * @description: forget what was sent, e.g. when the controller state can no longer be trusted
+ */
+void invalidateFrameDeltaFilter(FrameDeltaFilter* filter);
+
+/**
+ * @description: drop the frames that would not change their panel, compacting the remaining ones in place.
+ * A frame whose count or panel order differs from the previous one is sent completely
+ * @params frames: the generated frames, replaced with only the changed ones
+ * @params nFrames: number of generated frames
+ * @return: the number of frames left, 0 if nothing changed
+ */
+int filterUnchangedFrames(FrameDeltaFilter* filter, Frame_t* frames, int nFrames);
+
+/**
+ * @description: release the arrays of the filter
+ */
+void freeFrameDeltaFilter(FrameDeltaFilter* filter);
+
+#endif /* INC_FRAMEDELTAFILTER_H_ */
@@ -0,0 +1,82 @@
+/*
+ * FrameScheduler.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_FRAMESCHEDULER_H_
+#define INC_FRAMESCHEDULER_H_
+
+#include <stdint.h>
+
+#define SLEEP_TIME_UNIT_NANOSECONDS 100000000ULL	/*sleepTime is expressed in multiples of 100ms*/
+#define MINIMUM_SLEEP_TIME 1
+
+/**
+ * A source of monotonic time in nanoseconds, with an opaque context so that tests can drive a virtual clock
+ */
+typedef uint64_t (*SchedulerClock)(void* context);
+
+/**
+ * A clock that only moves when told to, see virtualClockNow
+ */
+struct VirtualClock {
+	uint64_t nanoseconds;
+};
+
+struct FrameSchedulerStatistics {
+	uint32_t intervalsCount;		/*number of measured call-to-call intervals*/
+	uint32_t resyncsCount;			/*number of times the timeline was restarted because a call was far off target*/
+	int64_t meanLateness;			/*average of call time minus target time, in nanoseconds*/
+	int64_t maximumLateness;		/*latest call compared to its target, in nanoseconds*/
+	int64_t minimumLateness;		/*earliest call compared to its target, in nanoseconds*/
+	uint64_t rmsJitter;				/*root mean square of the lateness, in nanoseconds*/
+};
+
+struct FrameScheduler {
+	SchedulerClock clock;
+	void* clockContext;
+	bool started;
+	uint64_t targetTime;			/*when the current call was supposed to happen*/
+	uint64_t period;				/*the nominal period that led to targetTime, in nanoseconds*/
+	uint32_t intervalsCount;
+	uint32_t resyncsCount;
+	int64_t latenessSum;
+	uint64_t squaredLatenessSum;	/*in squared microseconds, so that it does not overflow*/
+	int64_t maximumLateness;
+	int64_t minimumLateness;
+};
+
+/**
+ * @description: the default clock, reading CLOCK_MONOTONIC. The context is ignored
+ */
+uint64_t monotonicClockNow(void* context);
+
+/**
+ * @description: a clock reading a VirtualClock
+ * @params context: a pointer to the VirtualClock
+ */
+uint64_t virtualClockNow(void* context);
+
+/**
+ * @description: reset the scheduler, the next call to scheduleNextFrame starts a new timeline
+ * @params clock: where to read the time from, monotonicClockNow in production
+ * @params clockContext: passed as is to the clock
+ */
+void initFrameScheduler(FrameScheduler* scheduler, SchedulerClock clock, void* clockContext);
+
+/**
+ * @description: to be called once per getPluginFrame. Keeps a target timeline advancing by exactly the nominal
+ * sleep time on every call, and returns the sleep time that brings the next call back onto it,
+ * absorbing the time spent in the call itself, the dispatch latency of the host and the rounding to 100ms units
+ * @params nominalSleepTime: the sleep time the effect wants, in multiples of 100ms
+ * @return: the corrected sleep time, in multiples of 100ms, never less than MINIMUM_SLEEP_TIME
+ */
+int scheduleNextFrame(FrameScheduler* scheduler, int nominalSleepTime);
+
+/**
+ * @description: summarize how far the calls landed from the target timeline
+ */
+void getFrameSchedulerStatistics(const FrameScheduler* scheduler, FrameSchedulerStatistics* statistics);
+
+#endif /* INC_FRAMESCHEDULER_H_ */
@@ -0,0 +1,64 @@
+/*
+ * FrameSliceTable.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_FRAMESLICETABLE_H_
+#define INC_FRAMESLICETABLE_H_
+
+#include <stddef.h>
+
+#include "LayoutProcessingUtils.h"
+
+struct FrameSliceTable;
+
+void freeFrameSliceTable(FrameSliceTable* table);
+
+/**
+ * Frame slices in compressed sparse row form: the panelIds of every slice one after the other in a single array,
+ * and where each slice starts in it. Iterating all the slices is a single linear scan of panelIds
+ */
+struct FrameSliceTable {
+	int nFrameSlices;			/*number of slices*/
+	int nPanelIds;				/*total number of panelIds, over all the slices*/
+	int* offsets;				/*nFrameSlices + 1 entries, the panelIds of slice i are [offsets[i], offsets[i + 1])*/
+	int* panelIds;				/*the panelIds of all the slices*/
+	FrameSliceTable(const FrameSliceTable&) = delete;
+	FrameSliceTable(){
+		nFrameSlices = 0;
+		nPanelIds = 0;
+		offsets = NULL;
+		panelIds = NULL;
+	}
+	~FrameSliceTable(){
+		freeFrameSliceTable(this);
+	}
+
+	int getFrameSliceSize(int frameSliceIndex) const {
+		return offsets[frameSliceIndex + 1] - offsets[frameSliceIndex];
+	}
+
+	const int* getFrameSlicePanelIds(int frameSliceIndex) const {
+		return panelIds + offsets[frameSliceIndex];
+	}
+};
+
+/**
+ * @description: allocate both arrays of a table at once, any previous content is released
+ */
+void allocateFrameSliceTable(FrameSliceTable* table, int nFrameSlices, int nPanelIds);
+
+/**
+ * @description: adapter from the frame slices of getFrameSlicesFromLayoutForTriangle
+ * @params frameSlices, nFrameSlices: the slices to convert, they are not freed
+ * @params table: the table to fill, any previous content is released
+ */
+void buildFrameSliceTable(const FrameSlice_t* frameSlices, int nFrameSlices, FrameSliceTable* table);
+
+/**
+ * @description: release the arrays of the table
+ */
+void freeFrameSliceTable(FrameSliceTable* table);
+
+#endif /* INC_FRAMESLICETABLE_H_ */
@@ -0,0 +1,95 @@
+/*
+ * FrameTrace.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_FRAMETRACE_H_
+#define INC_FRAMETRACE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "AuroraPlugin.h"
+
+//#define FRAME_RECORDING_ENABLED
+#define FRAME_TRACE_PATH "/tmp/AuroraPlugin.trace"
+
+/*
+ * Trace layout, in the byte order of the machine that recorded it:
+ *
+ *   FrameTraceHeader
+ *   then, for every getPluginFrame call:
+ *     FrameTraceRecordHeader
+ *     nFrames entries, each a FrameTraceField mask byte followed by the int32 values of the fields set in the mask,
+ *     the fields that are not set are equal to the entry at the same index of the previous record
+ *
+ * The file is only ever appended to, and the reader walks it straight from a read-only mapping.
+ */
+
+#define FRAME_TRACE_MAGIC 0x54464C4E			/*"NLFT"*/
+#define FRAME_TRACE_VERSION 1
+
+enum FrameTraceField {
+	FRAME_TRACE_FIELD_PANEL_ID = 1 << 0,
+	FRAME_TRACE_FIELD_R = 1 << 1,
+	FRAME_TRACE_FIELD_G = 1 << 2,
+	FRAME_TRACE_FIELD_B = 1 << 3,
+	FRAME_TRACE_FIELD_TRANS_TIME = 1 << 4
+};
+
+struct FrameTraceHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t maximumFrames;				/*the largest nFrames of any record*/
+	uint32_t reserved;
+};
+
+struct FrameTraceRecordHeader {
+	uint64_t timestamp;					/*nanoseconds since the first record*/
+	int32_t sleepTime;					/*the sleepTime returned with the frames, -1 for sound plugins*/
+	uint32_t nFrames;					/*number of entries in the record*/
+	uint32_t payloadSize;				/*size in bytes of the entries that follow*/
+	uint32_t reserved;
+};
+
+struct FrameTraceRecorder {
+	FILE* file;
+	int maximumFrames;
+	Frame_t* previousFrames;			/*what the entries are delta-encoded against*/
+	int previousFramesCount;
+	uint8_t* encodeBuffer;				/*preallocated, large enough for a record of maximumFrames entries*/
+	uint64_t startTime;
+	bool started;
+};
+
+/**
+ * @description: create or truncate a trace file and get ready to record into it
+ * @params maximumFrames: the largest nFrames that will be recorded, usually the number of panels
+ * @return: true on success
+ */
+bool openFrameTraceRecorder(FrameTraceRecorder* recorder, const char* path, int maximumFrames);
+
+/**
+ * @description: append the output of one getPluginFrame call to the trace. Does not allocate
+ * @params sleepTime: the returned sleepTime, NULL for sound plugins
+ */
+void recordTraceFrame(FrameTraceRecorder* recorder, const Frame_t* frames, int nFrames, const int* sleepTime);
+
+/**
+ * @description: flush and close the trace, and release the buffers of the recorder
+ */
+void closeFrameTraceRecorder(FrameTraceRecorder* recorder);
+
+#ifdef FRAME_RECORDING_ENABLED
+#define RECORD_TRACE_OPEN(recorder, maximumFrames) openFrameTraceRecorder((recorder), FRAME_TRACE_PATH, (maximumFrames))
+#define RECORD_TRACE_FRAME(recorder, frames, nFrames, sleepTime) recordTraceFrame((recorder), (frames), (nFrames), (sleepTime))
+#define RECORD_TRACE_CLOSE(recorder) closeFrameTraceRecorder(recorder)
+#else
+#define RECORD_TRACE_OPEN(recorder, maximumFrames) {}
+#define RECORD_TRACE_FRAME(recorder, frames, nFrames, sleepTime) {}
+#define RECORD_TRACE_CLOSE(recorder) {}
+#endif
+
+#endif /* INC_FRAMETRACE_H_ */
@@ -0,0 +1,38 @@
+/*
+ * IntegerMath.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_INTEGERMATH_H_
+#define INC_INTEGERMATH_H_
+
+#include <stdint.h>
+
+/**
+ * @description: compute the integer square root, bit by bit, without any floating point
+ * @params value: the value to take the root of
+ * @return: the largest integer whose square is at most value
+ */
+inline uint64_t integerSquareRoot(uint64_t value) {
+	uint64_t root = 0;
+	uint64_t bit = (uint64_t)1 << 62;
+
+	while (bit > value) {
+		bit >>= 2;
+	}
+
+	while (bit != 0) {
+		if (value >= root + bit) {
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		} else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return root;
+}
+
+#endif /* INC_INTEGERMATH_H_ */
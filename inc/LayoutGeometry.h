@@ -0,0 +1,168 @@
+/*
+ * LayoutGeometry.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_LAYOUTGEOMETRY_H_
+#define INC_LAYOUTGEOMETRY_H_
+
+#include <stddef.h>
+#include <vector>
+
+#include "LayoutProcessingUtils.h"
+#include "Coordinate.h"
+#include "PointArray.h"
+#include "FrameSliceTable.h"
+
+#define SNAPPED_ORIENTATION_STEP 30
+#define SNAPPED_ORIENTATIONS_COUNT 12
+
+struct LayoutGeometry;
+
+void freeLayoutGeometry(LayoutGeometry* geometry);
+
+/**
+ * A flattened copy of the layout, with every coordinate stored in contiguous arrays carved out of one allocation
+ */
+struct LayoutGeometry {
+	int nPanels;				/*number of panels in the layout*/
+	int* panelIds;				/*the panelId of each panel*/
+	int* shapeTypes;			/*the shapeType of each panel, as indicated in Shape.h*/
+	int* orientations;			/*the orientation of each panel, in degrees*/
+	PointArray centroids;		/*the centroid of each panel*/
+	int* vertexOffsets;			/*nPanels + 1 entries, the vertices of panel i are [vertexOffsets[i], vertexOffsets[i + 1])*/
+	PointArray vertices;		/*every vertex of every panel*/
+	int totalRotation;			/*the snapped angle the geometry has been rotated through, in degrees*/
+	char* arena;				/*the single buffer backing all the arrays above*/
+	void* mapping;				/*when loaded from a fixture, the file mapping that holds the arena instead*/
+	size_t mappingSize;
+	LayoutGeometry(const LayoutGeometry&) = delete;
+	LayoutGeometry(){
+		nPanels = 0;
+		panelIds = NULL;
+		shapeTypes = NULL;
+		orientations = NULL;
+		vertexOffsets = NULL;
+		totalRotation = 0;
+		arena = NULL;
+		mapping = NULL;
+		mappingSize = 0;
+	}
+	~LayoutGeometry(){
+		freeLayoutGeometry(this);
+	}
+};
+
+/**
+ * @description: snap an angle to the closest multiple of 30 degrees
+ * @params angle_degrees: the angle to snap, any sign and magnitude
+ * @return: the index of the snapped angle, between 0 and SNAPPED_ORIENTATIONS_COUNT - 1
+ */
+int snapOrientationIndex(int angle_degrees);
+
+/**
+ * @description: flatten the centroids and the vertices of every panel into contiguous arrays
+ * @params layoutData: the layout to copy, it is not modified
+ * @params geometry: the geometry to fill, any previous content is released
+ */
+void buildLayoutGeometry(LayoutData* layoutData, LayoutGeometry* geometry);
+
+/**
+ * Internal helper: the size of the arena backing a geometry, every array aligned on 8 bytes
+ */
+size_t getLayoutGeometryArenaSize(int nPanels, int nVertices);
+
+/**
+ * Internal helper: point the arrays of the geometry into an arena of getLayoutGeometryArenaSize bytes
+ */
+void carveLayoutGeometry(LayoutGeometry* geometry, char* arena, int nPanels, int nVertices);
+
+/**
+ * @description: allocate an uninitialized geometry, any previous content is released
+ */
+void allocateLayoutGeometry(LayoutGeometry* geometry, int nPanels, int nVertices);
+
+/**
+ * @description: rotate the whole geometry through the angle snapped to the closest multiple of 30 degrees.
+ * All the centroids and vertices are transformed in one pass using exact sine and cosine tables,
+ * so the result is the same on every target, with or without an FPU.
+ * With FIXED_POINT_GEOMETRY defined the whole pass is integer arithmetic
+ * @params geometry: the geometry to rotate
+ * @params angle_degrees: the angle to rotate through, replaced with the snapped angle
+ */
+void rotateLayoutGeometry(LayoutGeometry* geometry, int* angle_degrees);
+
+/**
+ * @description: same as getFrameSlicesFromLayoutForTriangle, but working on the flattened geometry.
+ * The grid spacing is 0.5*sideLength if the rotation is a multiple of 60 degrees and sqrt(3)/6*sideLength if it is not.
+ * Centroids are snapped to the closest grid line, so rounding noise never moves a panel to a neighbouring slice.
+ * The panels are bucketed with a counting sort straight into the table, without any per-slice allocation
+ * @params geometry: the geometry to process
+ * @params frameSlices: filled with the slices, ordered along the x axis, any previous content is released
+ */
+void getFrameSlicesFromGeometryForTriangle(const LayoutGeometry* geometry, FrameSliceTable* frameSlices);
+
+/**
+ * @description: get the slice width that puts every row of panels in its own slice when sweeping along a direction.
+ * That is the triangle grid spacing when the geometry holds triangles, else the distance between the projections
+ * of neighbouring squares
+ * @params geometry: the geometry to process
+ * @params angle_degrees: the direction to sweep along, relative to the x axis of the geometry
+ * @return: the slice width
+ */
+coord_t getFrameSliceWidth(const LayoutGeometry* geometry, int angle_degrees);
+
+/**
+ * @description: slice the geometry along any direction, for any shape type. The centroids are projected onto the
+ * direction, sorted, and swept into slices of sliceWidth, each projection snapped to the closest multiple of sliceWidth
+ * from the lowest one. Panels keep the layout order within a slice, and slices with no panel are kept so that the
+ * slice index stays proportional to the position. SHAPE_RHYTHM modules have no LEDs and are left out.
+ * Sweeping along 0 degrees with getFrameSliceWidth gives the same slices as getFrameSlicesFromGeometryForTriangle
+ * @params geometry: the geometry to process
+ * @params angle_degrees: the direction to sweep along, relative to the x axis of the geometry
+ * @params sliceWidth: the width of a slice, must be positive
+ * @params frameSlices: filled with the slices, ordered along the direction, any previous content is released
+ */
+void getFrameSlicesFromGeometry(const LayoutGeometry* geometry, int angle_degrees, coord_t sliceWidth, FrameSliceTable* frameSlices);
+
+/**
+ * @description: slice the geometry for each of the snapped orientations in one pass, so that a change of
+ * globalOrientation only has to pick another table. Table k holds the slices that rotating the geometry through
+ * k * SNAPPED_ORIENTATION_STEP degrees and then calling getFrameSlicesFromGeometry along 0 degrees, with
+ * getFrameSliceWidth, would give. Opposite orientations share the same projections, negated
+ * @params geometry: the geometry to process, it is not rotated
+ * @params frameSlices: SNAPPED_ORIENTATIONS_COUNT tables, filled, any previous content is released
+ */
+void getFrameSlicesForAllOrientations(const LayoutGeometry* geometry, FrameSliceTable* frameSlices);
+
+/**
+ * @description: same as isPointInsidePanel, but working on the flattened geometry. Panels are assumed to be convex
+ * @params geometry: the geometry holding the panel
+ * @params panelIndex: the index of the panel in the geometry arrays
+ * @params x, y: the point to be tested
+ * @return: true if inside, else false
+ */
+bool isPointInsideGeometryPanel(const LayoutGeometry* geometry, int panelIndex, coord_t x, coord_t y);
+
+/**
+ * @description: same as pointInsideWhichPanel, but working on the flattened geometry
+ * @params geometry: the geometry to search
+ * @params x, y: the point to test
+ * @return: the panelId of the panel that the point is within, -1 if not inside any panel
+ */
+int pointInsideWhichGeometryPanel(const LayoutGeometry* geometry, coord_t x, coord_t y);
+
+/**
+ * @description: find the index in the geometry arrays of many panels at once, in O((n + m) log n)
+ * @params panelIds, nPanelIds: the panels to look for
+ * @params panelIndices: a buffer of at least nPanelIds elements, filled with the index of each panel, -1 if not found
+ */
+void findGeometryPanelIndices(const LayoutGeometry* geometry, const int* panelIds, int nPanelIds, int* panelIndices);
+
+/**
+ * @description: release the arrays of the geometry, or unmap them if they were loaded from a fixture
+ */
+void freeLayoutGeometry(LayoutGeometry* geometry);
+
+#endif /* INC_LAYOUTGEOMETRY_H_ */
@@ -9,6 +9,7 @@
 #define INC_LOGGER_H_
 
 #include <stdio.h>
+#include <stdint.h>
 
 //#define LOGGING_ENABLED
 
@@ -18,4 +19,75 @@
 #define PRINTLOG(format, ...) {}
 #endif
 
+/*
+ * Binary ring logger.
+ *
+ * LOG_* calls only copy a timestamp, the format string pointer and up to LOG_RECORD_ARGUMENTS_COUNT integer
+ * arguments into a preallocated lock-free ring, the formatting is deferred to dumpLogRecords.
+ * The format must be a string literal, and must only use integer conversions.
+ * When the ring is full the oldest records are overwritten.
+ */
+
+#define LOG_RING_CAPACITY 256			/*must be a power of two*/
+#define LOG_RECORD_ARGUMENTS_COUNT 4
+
+enum LogLevel {
+	LOG_LEVEL_NONE = 0,
+	LOG_LEVEL_ERROR,
+	LOG_LEVEL_WARNING,
+	LOG_LEVEL_INFO,
+	LOG_LEVEL_DEBUG
+};
+
+struct LogRecord {
+	uint64_t sequence;					/*index of the record plus one, once the record is completely written*/
+	uint64_t timestamp;					/*monotonic time of the call, in microseconds*/
+	const char* format;					/*the format string, only formatted when dumped*/
+	int32_t arguments[LOG_RECORD_ARGUMENTS_COUNT];
+	uint8_t level;
+	uint8_t nArguments;
+};
+
+/**
+ * @description: set the most verbose level that is recorded, LOG_LEVEL_WARNING by default
+ */
+void setLogLevel(int level);
+
+/**
+ * @description: get the most verbose level that is recorded
+ */
+int getLogLevel();
+
+/**
+ * @description: append a record to the ring. Use the LOG_* macros instead
+ */
+void appendLogRecord(int level, const char* format, const int32_t* arguments, int nArguments);
+
+/**
+ * @description: format every record still in the ring that was not dumped yet, oldest first
+ * @params stream: where to print the records
+ * @return: the number of records printed
+ */
+int dumpLogRecords(FILE* stream);
+
+inline void logRecord(int level, const char* format) {
+	appendLogRecord(level, format, NULL, 0);
+}
+
+template <typename... Arguments>
+inline void logRecord(int level, const char* format, Arguments... arguments) {
+	static_assert(sizeof...(Arguments) <= LOG_RECORD_ARGUMENTS_COUNT, "Too many log arguments");
+
+	const int32_t values[] = { (int32_t)arguments... };
+
+	appendLogRecord(level, format, values, sizeof...(Arguments));
+}
+
+#define LOG_AT_LEVEL(level, format, ...) do { if ((level) <= getLogLevel()) { logRecord((level), format, ##__VA_ARGS__); } } while (0)
+
+#define LOG_ERROR(format, ...) LOG_AT_LEVEL(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#define LOG_WARNING(format, ...) LOG_AT_LEVEL(LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
+#define LOG_INFO(format, ...) LOG_AT_LEVEL(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#define LOG_DEBUG(format, ...) LOG_AT_LEVEL(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+
 #endif /* INC_LOGGER_H_ */
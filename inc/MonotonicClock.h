@@ -0,0 +1,25 @@
+/*
+ * MonotonicClock.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_MONOTONICCLOCK_H_
+#define INC_MONOTONICCLOCK_H_
+
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @description: read the monotonic clock, unaffected by wall-clock changes
+ * @return: the current time in nanoseconds, from an arbitrary origin
+ */
+inline uint64_t monotonicNanoseconds() {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+#endif /* INC_MONOTONICCLOCK_H_ */
@@ -0,0 +1,59 @@
+/*
+ * PaletteGradient.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_PALETTEGRADIENT_H_
+#define INC_PALETTEGRADIENT_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "ColorUtils.h"
+
+#define PALETTE_GRADIENT_SIZE 1024
+
+enum GradientSpace {
+	GRADIENT_RGB = 0,					/*straight lines between the colors, the way the panels cross-fade*/
+	GRADIENT_HSV						/*around the hue circle by the shortest way, e.g. red to green through amber*/
+};
+
+/**
+ * A palette sampled once at a high resolution, so that sampling it is a single indexed load.
+ * Sampling at the nearest entry rather than at the exact position costs up to a level per channel
+ * for palettes of a handful of colors, more for longer ones
+ */
+struct PaletteGradient {
+	uint8_t entries[PALETTE_GRADIENT_SIZE * 3];	/*r, g, b of every entry*/
+	std::vector<RGB_t> paletteColors;	/*the palette the entries were built from*/
+	int space;							/*the space the entries were built in*/
+	bool built;
+	PaletteGradient(const PaletteGradient&) = delete;
+	PaletteGradient(){
+		space = GRADIENT_RGB;
+		built = false;
+	}
+};
+
+/**
+ * @description: rebuild the entries, only if the palette or the space changed since the last build
+ * @params colors, nColors: the palette, spread evenly from the first to the last entry
+ * @params space: one of GradientSpace
+ * @return: true if the entries were rebuilt
+ */
+bool updatePaletteGradient(PaletteGradient* gradient, const RGB_t* colors, int nColors, int space);
+
+/**
+ * @description: sample the gradient
+ * @params position: from 0 to PALETTE_GRADIENT_SIZE - 1, clamped
+ */
+inline RGB_t samplePaletteGradient(const PaletteGradient* gradient, int position) {
+	position = position < 0 ? 0 : position >= PALETTE_GRADIENT_SIZE ? PALETTE_GRADIENT_SIZE - 1 : position;
+
+	const uint8_t* entry = gradient->entries + position * 3;
+
+	return {entry[0], entry[1], entry[2]};
+}
+
+#endif /* INC_PALETTEGRADIENT_H_ */
@@ -0,0 +1,62 @@
+/*
+ * PanelAdjacency.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_PANELADJACENCY_H_
+#define INC_PANELADJACENCY_H_
+
+#include <stddef.h>
+
+#include "LayoutGeometry.h"
+
+struct PanelAdjacency;
+
+void freePanelAdjacency(PanelAdjacency* adjacency);
+
+/**
+ * Which panels of a LayoutGeometry share an edge, in compressed sparse row form.
+ * Panels are referred to by their index in the geometry arrays, not by panelId
+ */
+struct PanelAdjacency {
+	int nPanels;				/*number of panels, same as the geometry*/
+	int nNeighbours;			/*total number of entries in neighbours, twice the number of shared edges*/
+	int* offsets;				/*nPanels + 1 entries, the neighbours of panel i are [offsets[i], offsets[i + 1])*/
+	int* neighbours;			/*the panel index of every neighbour of every panel*/
+	PanelAdjacency(const PanelAdjacency&) = delete;
+	PanelAdjacency(){
+		nPanels = 0;
+		nNeighbours = 0;
+		offsets = NULL;
+		neighbours = NULL;
+	}
+	~PanelAdjacency(){
+		freePanelAdjacency(this);
+	}
+
+	int getNeighboursCount(int panelIndex) const {
+		return offsets[panelIndex + 1] - offsets[panelIndex];
+	}
+
+	const int* getNeighbours(int panelIndex) const {
+		return neighbours + offsets[panelIndex];
+	}
+};
+
+/**
+ * @description: find the panels that share an edge. Every edge midpoint is quantized to a grid of a quarter
+ * sideLength and looked up in a hash table, so the whole layout is processed in O(n) expected time instead of
+ * comparing every panel against every other one. Two edges are shared when their midpoints are closer than
+ * a twentieth of sideLength. SHAPE_RHYTHM modules are not panels and get no neighbours
+ * @params geometry: the geometry to process, in any rotation
+ * @params adjacency: filled with the graph, any previous content is released
+ */
+void buildPanelAdjacency(const LayoutGeometry* geometry, PanelAdjacency* adjacency);
+
+/**
+ * @description: release the arrays of the graph
+ */
+void freePanelAdjacency(PanelAdjacency* adjacency);
+
+#endif /* INC_PANELADJACENCY_H_ */
@@ -0,0 +1,75 @@
+/*
+ * PanelCalibration.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_PANELCALIBRATION_H_
+#define INC_PANELCALIBRATION_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PANEL_CALIBRATION_PATH "/data/AuroraPlugin.calibration"
+#define PANEL_CALIBRATION_GAIN_BITS 8
+#define PANEL_CALIBRATION_UNIT_GAIN (1 << PANEL_CALIBRATION_GAIN_BITS)	/*a gain of 1*/
+
+/*
+ * Calibration file layout, plain text, one panel per line:
+ *
+ *   panelId redGain greenGain blueGain redOffset greenOffset blueOffset
+ *
+ * with the gains in percent and the offsets in levels, added after the gain to the channels that are lit, so that
+ * panels that are off stay off. Lines starting with # are comments.
+ * Panels of the file that are not in the layout are ignored, panels of the layout that are not in the file are
+ * left as they are.
+ */
+
+struct PanelCalibration;
+
+void freePanelCalibration(PanelCalibration* calibration);
+
+/**
+ * The gain and offset of every channel of every panel, laid out in frame order so that the frame is corrected
+ * in one pass without any lookup
+ */
+struct PanelCalibration {
+	int nPanels;				/*number of panels in the frame*/
+	uint16_t* gains;			/*nPanels * FRAME_CHANNELS_COUNT values, in PANEL_CALIBRATION_UNIT_GAIN units*/
+	int16_t* offsets;			/*nPanels * FRAME_CHANNELS_COUNT values, in levels*/
+	bool identity;				/*true when no panel is corrected, the pass is then skipped*/
+	PanelCalibration(const PanelCalibration&) = delete;
+	PanelCalibration(){
+		nPanels = 0;
+		gains = NULL;
+		offsets = NULL;
+		identity = true;
+	}
+	~PanelCalibration(){
+		freePanelCalibration(this);
+	}
+};
+
+/**
+ * @description: read a calibration file and lay it out along the frame order, once at init
+ * @params path: the calibration file
+ * @params panelIds: the panelId of each panel, in frame order
+ * @params nPanels: number of panels in the frame
+ * @return: the number of panels of the frame that are calibrated, -1 if the file cannot be read.
+ * In both cases the calibration is usable, panels without an entry are left as they are
+ */
+int loadPanelCalibration(PanelCalibration* calibration, const char* path, const int* panelIds, int nPanels);
+
+/**
+ * @description: correct every channel of a frame in place, in one pass, just before it is sent
+ * @params channels: nPanels * FRAME_CHANNELS_COUNT values, as in FrameCompositor.output
+ * @params nPanels: number of panels, at most calibration->nPanels
+ */
+void applyPanelCalibration(const PanelCalibration* calibration, uint8_t* channels, int nPanels);
+
+/**
+ * @description: release the arrays of the calibration
+ */
+void freePanelCalibration(PanelCalibration* calibration);
+
+#endif /* INC_PANELCALIBRATION_H_ */
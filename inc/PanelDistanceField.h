@@ -0,0 +1,84 @@
+/*
+ * PanelDistanceField.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_PANELDISTANCEFIELD_H_
+#define INC_PANELDISTANCEFIELD_H_
+
+#include <stdint.h>
+
+#include "LayoutGeometry.h"
+#include "PanelAdjacency.h"
+#include "FrameCompositor.h"
+
+#define UNREACHABLE_GRAPH_DISTANCE 255			/*graph distance of the panels with no path to the source, or too far*/
+#define MAXIMUM_EUCLIDEAN_DISTANCE 65535
+#define EUCLIDEAN_DISTANCE_UNITS_PER_SIDE 16	/*euclidean distances are stored in sixteenths of Shape::sideLength*/
+
+#define GLOW_FALLOFF_LEVELS_COUNT 256
+
+enum DistanceMetric {
+	DISTANCE_GRAPH = 0,						/*number of shared edges to cross*/
+	DISTANCE_EUCLIDEAN						/*between the centroids*/
+};
+
+struct PanelDistanceField;
+
+void freePanelDistanceField(PanelDistanceField* field);
+
+/**
+ * The distance from one source panel to every panel, stored in the frame order so that
+ * an effect reads it in the same linear pass as the frame layer it fills
+ */
+struct PanelDistanceField {
+	int nPanels;						/*number of panels in the frame order*/
+	uint8_t* graphDistances;			/*hops from the source, saturating at UNREACHABLE_GRAPH_DISTANCE*/
+	uint16_t* euclideanDistances;		/*in 1/EUCLIDEAN_DISTANCE_UNITS_PER_SIDE of a side, saturating at MAXIMUM_EUCLIDEAN_DISTANCE*/
+	PanelDistanceField(const PanelDistanceField&) = delete;
+	PanelDistanceField(){
+		nPanels = 0;
+		graphDistances = NULL;
+		euclideanDistances = NULL;
+	}
+	~PanelDistanceField(){
+		freePanelDistanceField(this);
+	}
+};
+
+/**
+ * @description: compute the graph distance, with a breadth first search over the adjacency, and the euclidean
+ * distance from the source panel to every panel. To be called at init, once per source panel
+ * @params geometry, adjacency: the layout and its graph
+ * @params sourcePanelIndex: the index of the source panel in the geometry arrays
+ * @params panelIndices: the index in the geometry arrays of the panel at every frame index
+ * @params nPanels: number of frame indices
+ * @params field: filled with the distances in the frame order, any previous content is released
+ */
+void buildPanelDistanceField(const LayoutGeometry* geometry, const PanelAdjacency* adjacency, int sourcePanelIndex, const int* panelIndices, int nPanels, PanelDistanceField* field);
+
+/**
+ * @description: fill a glow falloff table, from fully lit at distance 0 down to dark at the radius, with a quadratic ease
+ * @params levels: GLOW_FALLOFF_LEVELS_COUNT entries, the alpha for every distance
+ * @params radius: the distance at which the glow fades out, in the units of the metric it is used with
+ */
+void buildGlowFalloff(uint8_t* levels, int radius);
+
+/**
+ * @description: paint the glow of a color around the source of a field into a layer with alphas, in one
+ * table-driven pass. Distances past the end of the table are dark
+ * @params layer: the layer to fill, every panel is overwritten
+ * @params field: the distances to the source
+ * @params metric: one of DistanceMetric
+ * @params levels: the falloff table from buildGlowFalloff
+ * @params color: the color of the glow
+ */
+void glowFrameLayer(FrameLayer* layer, const PanelDistanceField* field, int metric, const uint8_t* levels, const RGB_t& color);
+
+/**
+ * @description: release the arrays of the field
+ */
+void freePanelDistanceField(PanelDistanceField* field);
+
+#endif /* INC_PANELDISTANCEFIELD_H_ */
@@ -0,0 +1,46 @@
+/*
+ * PanelOrdering.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_PANELORDERING_H_
+#define INC_PANELORDERING_H_
+
+#include <stdint.h>
+
+#include "LayoutGeometry.h"
+
+#define PANEL_CURVE_BITS 16			/*centroids are quantized to a 2^16 x 2^16 grid before being put on a curve*/
+
+enum PanelOrder {
+	PANEL_ORDER_SLICES = 0,			/*keep the order given, e.g. the frame slices*/
+	PANEL_ORDER_MORTON,				/*along a Z-order curve, cheap to compute*/
+	PANEL_ORDER_HILBERT				/*along a Hilbert curve, consecutive panels always neighbours on the grid*/
+};
+
+/**
+ * @description: get the position of a grid cell along the Morton curve
+ * @params x, y: the cell, below 2^PANEL_CURVE_BITS
+ */
+uint32_t getMortonIndex(uint32_t x, uint32_t y);
+
+/**
+ * @description: get the position of a grid cell along the Hilbert curve
+ * @params x, y: the cell, below 2^PANEL_CURVE_BITS
+ */
+uint32_t getHilbertIndex(uint32_t x, uint32_t y);
+
+/**
+ * @description: reorder panels along a space-filling curve through their centroids, so that panels close
+ * on the wall end up close in every per-panel array. Panels on the same cell keep the order given
+ * @params geometry: the layout
+ * @params panelIndices: the index in the geometry arrays of every panel to order
+ * @params nPanels: number of panels to order
+ * @params order: one of PanelOrder
+ * @params permutation: a buffer of at least nPanels elements, filled with the position in panelIndices of the panel
+ * that comes at every position in the new order
+ */
+void orderPanelsAlongCurve(const LayoutGeometry* geometry, const int* panelIndices, int nPanels, int order, int* permutation);
+
+#endif /* INC_PANELORDERING_H_ */
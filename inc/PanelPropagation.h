@@ -0,0 +1,99 @@
+/*
+ * PanelPropagation.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_PANELPROPAGATION_H_
+#define INC_PANELPROPAGATION_H_
+
+#include <stdint.h>
+
+#include "PanelAdjacency.h"
+#include "FrameCompositor.h"
+
+#define PROPAGATION_MAXIMUM_DEGREE_PER_ROW 4	/*up to this many neighbours, rows are padded to a fixed width*/
+#define PROPAGATION_MAXIMUM_HEIGHT 4096			/*heights of the ripple rule are clamped to +-this*/
+#define PROPAGATION_FULL_RETENTION 256
+
+enum PropagationRule {
+	PROPAGATION_RIPPLE = 0,					/*a damped wave, one height per panel*/
+	PROPAGATION_DIFFUSION					/*colors bleeding into the neighbours, packed r, g, b per panel*/
+};
+
+struct PanelPropagation;
+
+void freePanelPropagation(PanelPropagation* propagation);
+
+/**
+ * A cellular update rule run over the panel graph, double buffered: every step reads one buffer and writes
+ * the other, then they are swapped. Everything is in the frame order and allocated once, at init.
+ * When no panel has more than PROPAGATION_MAXIMUM_DEGREE_PER_ROW neighbours, as with triangles and squares,
+ * the neighbours are stored as fixed-width rows padded with a ghost panel that is always dark, so the inner
+ * loop has a constant trip count and no branch
+ */
+struct PanelPropagation {
+	int nPanels;					/*number of panels, the ghost panel is at index nPanels*/
+	int rule;						/*one of PropagationRule*/
+	int retention;					/*fraction kept at every step, out of PROPAGATION_FULL_RETENTION*/
+	int rowWidth;					/*neighbours per padded row, 0 when the rows are irregular and offsets is used*/
+	int* offsets;					/*nPanels + 1 entries when rowWidth is 0, else NULL*/
+	int* neighbours;				/*the frame index of every neighbour, row after row*/
+	int32_t* reciprocals;			/*the fixed point reciprocal of the divisor of every panel*/
+	int16_t* heights[2];			/*ripple only, (nPanels + 1) heights per buffer*/
+	uint8_t* channels[2];			/*diffusion only, (nPanels + 1) * FRAME_CHANNELS_COUNT values per buffer*/
+	int currentBuffer;				/*the buffer holding the current state*/
+	RGB_t color;					/*ripple only, the color of the highest crests*/
+	PanelPropagation(const PanelPropagation&) = delete;
+	PanelPropagation(){
+		nPanels = 0;
+		rule = PROPAGATION_RIPPLE;
+		retention = PROPAGATION_FULL_RETENTION;
+		rowWidth = 0;
+		offsets = NULL;
+		neighbours = NULL;
+		reciprocals = NULL;
+		heights[0] = heights[1] = NULL;
+		channels[0] = channels[1] = NULL;
+		currentBuffer = 0;
+		color = {0, 0, 0};
+	}
+	~PanelPropagation(){
+		freePanelPropagation(this);
+	}
+};
+
+/**
+ * @description: allocate the buffers and lay the adjacency out in the frame order, everything starts dark
+ * @params adjacency: the graph, in geometry indices
+ * @params panelIndices: the index in the geometry arrays of the panel at every frame index
+ * @params nPanels: number of frame indices
+ * @params rule: one of PropagationRule
+ * @params retention: fraction of the amplitude kept at every step, out of PROPAGATION_FULL_RETENTION
+ * @params propagation: the engine to initialize, any previous content is released
+ */
+void initPanelPropagation(const PanelAdjacency* adjacency, const int* panelIndices, int nPanels, int rule, int retention, PanelPropagation* propagation);
+
+/**
+ * @description: start a disturbance at one panel. The ripple rule lifts the panel to the maximum height and
+ * takes the color for its crests, the diffusion rule sets the color of the panel
+ */
+void seedPanelPropagation(PanelPropagation* propagation, int frameIndex, const RGB_t& color);
+
+/**
+ * @description: run the rule once over every panel, in time linear in the number of panels
+ * @return: true while some panel is still lit, once false nothing is left of the wave and the next seed starts afresh
+ */
+bool stepPanelPropagation(PanelPropagation* propagation);
+
+/**
+ * @description: write the current state into a layer, meant for BLEND_ADD
+ */
+void renderPanelPropagation(const PanelPropagation* propagation, FrameLayer* layer);
+
+/**
+ * @description: release the buffers
+ */
+void freePanelPropagation(PanelPropagation* propagation);
+
+#endif /* INC_PANELPROPAGATION_H_ */
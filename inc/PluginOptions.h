@@ -1,7 +1,7 @@
 #ifndef PLUGIN_OPTIONS_H
 #define PLUGIN_OPTIONS_H
 
-const char* pluginOptionsJsonString = "{\"options\": [{\"defaultValue\": 50, \"minValue\": 1, \"type\": \"int\", \"name\": \"transTime\", \"maxValue\": 600}]}";
+const char* pluginOptionsJsonString = "{\"options\": [{\"defaultValue\": 50, \"minValue\": 1, \"type\": \"int\", \"name\": \"transTime\", \"maxValue\": 600}, {\"defaultValue\": 1, \"minValue\": 1, \"type\": \"int\", \"name\": \"fadeTime\", \"maxValue\": 600}, {\"defaultValue\": 0, \"minValue\": 0, \"type\": \"int\", \"name\": \"backgroundBrightness\", \"maxValue\": 100}, {\"defaultValue\": 0, \"minValue\": 0, \"type\": \"int\", \"name\": \"backgroundGradient\", \"maxValue\": 1}, {\"defaultValue\": 0, \"minValue\": 0, \"type\": \"int\", \"name\": \"glowRadius\", \"maxValue\": 15}, {\"defaultValue\": 0, \"minValue\": 0, \"type\": \"int\", \"name\": \"ripple\", \"maxValue\": 99}, {\"defaultValue\": 0, \"minValue\": 0, \"type\": \"int\", \"name\": \"panelOrder\", \"maxValue\": 2}, {\"defaultValue\": 100, \"minValue\": 1, \"type\": \"int\", \"name\": \"brightness\", \"maxValue\": 100}, {\"defaultValue\": 0, \"minValue\": 0, \"type\": \"int\", \"name\": \"gamma\", \"maxValue\": 1}, {\"defaultValue\": 0, \"minValue\": 0, \"type\": \"int\", \"name\": \"dither\", \"maxValue\": 1}, {\"defaultValue\": 0, \"minValue\": 0, \"type\": \"int\", \"name\": \"colorVision\", \"maxValue\": 3}, {\"defaultValue\": 100, \"minValue\": 1, \"type\": \"int\", \"name\": \"whiteRed\", \"maxValue\": 100}, {\"defaultValue\": 100, \"minValue\": 1, \"type\": \"int\", \"name\": \"whiteGreen\", \"maxValue\": 100}, {\"defaultValue\": 100, \"minValue\": 1, \"type\": \"int\", \"name\": \"whiteBlue\", \"maxValue\": 100}, {\"defaultValue\": 100, \"minValue\": 1, \"type\": \"int\", \"name\": \"powerBudget\", \"maxValue\": 100}, {\"defaultValue\": 0, \"minValue\": 0, \"type\": \"int\", \"name\": \"energyBrightness\", \"maxValue\": 1}, {\"defaultValue\": 60, \"minValue\": 1, \"type\": \"int\", \"name\": \"energyAttack\", \"maxValue\": 100}, {\"defaultValue\": 15, \"minValue\": 1, \"type\": \"int\", \"name\": \"energyRelease\", \"maxValue\": 100}, {\"defaultValue\": 2, \"minValue\": 0, \"type\": \"int\", \"name\": \"logLevel\", \"maxValue\": 4}]}";
 
 #ifdef __cplusplus
 extern "C" {
@@ -0,0 +1,89 @@
+/*
+ * PointArray.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_POINTARRAY_H_
+#define INC_POINTARRAY_H_
+
+#include <type_traits>
+
+#include "Coordinate.h"
+
+/**
+ * A plain value point, cheap to pass around and usable in constant expressions,
+ * for the code paths where Point and its heap allocated ToString are too heavy
+ */
+struct Vec2 {
+	coord_t x, y;
+
+	constexpr Vec2() : x(0), y(0) {}
+	constexpr Vec2(coord_t _x, coord_t _y) : x(_x), y(_y) {}
+
+	constexpr Vec2 operator+(const Vec2& other) const {
+		return Vec2(x + other.x, y + other.y);
+	}
+
+	constexpr Vec2 operator-(const Vec2& other) const {
+		return Vec2(x - other.x, y - other.y);
+	}
+
+	constexpr bool operator==(const Vec2& other) const {
+		return x == other.x && y == other.y;
+	}
+};
+
+static_assert(std::is_trivially_copyable<Vec2>::value, "Vec2 must stay trivially copyable");
+
+/**
+ * A structure of arrays view over many points. The storage is owned by whoever created the view
+ */
+struct PointArray {
+	coord_t* x;					/*the x coordinate of every point*/
+	coord_t* y;					/*the y coordinate of every point*/
+	int count;					/*number of points*/
+
+	PointArray() : x(NULL), y(NULL), count(0) {}
+	PointArray(coord_t* _x, coord_t* _y, int _count) : x(_x), y(_y), count(_count) {}
+
+	Vec2 get(int index) const {
+		return Vec2(x[index], y[index]);
+	}
+
+	void set(int index, const Vec2& point) {
+		x[index] = point.x;
+		y[index] = point.y;
+	}
+};
+
+/**
+ * @description: translate every point of the array by the same offset
+ */
+void translatePointArray(PointArray points, Vec2 offset);
+
+/**
+ * @description: rotate every point of the array around the origin
+ * @params sine, cosine: the sine and cosine of the angle to rotate through, as coordinates (e.g. COORD_FROM_RATIO(0.5))
+ */
+void rotatePointArray(PointArray points, coord_t sine, coord_t cosine);
+
+/**
+ * @description: compute the distance from every point of the array to a single point
+ * @params distances: a buffer of at least points.count elements, filled with the distances
+ */
+void distancesToPoint(PointArray points, Vec2 point, coord_t* distances);
+
+/**
+ * @description: project every point of the array onto a direction, i.e. x * cosine + y * sine
+ * @params sine, cosine: the sine and cosine of the direction, as coordinates
+ * @params projections: a buffer of at least points.count elements, filled with the projections
+ */
+void projectPointArray(PointArray points, coord_t sine, coord_t cosine, coord_t* projections);
+
+/**
+ * @description: compute the bounding box of the array. Both corners are left untouched if the array is empty
+ */
+void boundsOfPointArray(PointArray points, Vec2* minimum, Vec2* maximum);
+
+#endif /* INC_POINTARRAY_H_ */
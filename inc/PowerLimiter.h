@@ -0,0 +1,40 @@
+/*
+ * PowerLimiter.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_POWERLIMITER_H_
+#define INC_POWERLIMITER_H_
+
+#include <stdint.h>
+
+#define POWER_SCALE_BITS 16
+#define FULL_POWER_BUDGET 100		/*a budget of 100 percent lets every panel go full white*/
+
+/**
+ * Keeps the sum of the channels of the frame, which the drawn current follows, under a cap
+ */
+struct PowerLimiter {
+	uint32_t maximumChannelSum;		/*the largest sum of all the channels of a frame that is let through*/
+	bool enabled;					/*false when the budget can never be exceeded, the stage is then skipped*/
+	uint32_t limitedFramesCount;	/*the frames scaled down so far*/
+};
+
+/**
+ * @description: set the cap, once whenever the options change
+ * @params budget: the cap in percent of every panel at full white
+ * @params nPanels: number of panels in the frame
+ */
+void initPowerLimiter(PowerLimiter* limiter, int budget, int nPanels);
+
+/**
+ * @description: sum every channel of a frame and, if over the cap, scale them all by the same factor so that the
+ * sum ends up under the cap. Frames under the cap are only read
+ * @params channels: nPanels * FRAME_CHANNELS_COUNT values, as in FrameCompositor.output
+ * @params nPanels: number of panels
+ * @return: true if the frame was scaled down
+ */
+bool applyPowerLimiter(PowerLimiter* limiter, uint8_t* channels, int nPanels);
+
+#endif /* INC_POWERLIMITER_H_ */
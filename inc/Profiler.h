@@ -0,0 +1,81 @@
+/*
+ * Profiler.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_PROFILER_H_
+#define INC_PROFILER_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "MonotonicClock.h"
+
+//#define PROFILING_ENABLED
+
+/*
+ * Log-linear buckets, in the spirit of HDR histograms: every power of two is split into
+ * PROFILE_SUB_BUCKETS_COUNT linear sub-buckets, so any recorded value is known within 1/8 of itself.
+ */
+#define PROFILE_SUB_BUCKET_BITS 3
+#define PROFILE_SUB_BUCKETS_COUNT (1 << PROFILE_SUB_BUCKET_BITS)
+#define PROFILE_MAXIMUM_EXPONENT 40		/*about 18 minutes, in nanoseconds*/
+#define PROFILE_BUCKETS_COUNT ((PROFILE_MAXIMUM_EXPONENT - PROFILE_SUB_BUCKET_BITS + 2) * PROFILE_SUB_BUCKETS_COUNT)
+
+enum ProfilePhase {
+	PROFILE_PHASE_GET_LAYOUT_DATA = 0,
+	PROFILE_PHASE_ROTATE,
+	PROFILE_PHASE_SLICE,
+	PROFILE_PHASE_ADJACENCY,
+	PROFILE_PHASE_PLACEMENT,
+	PROFILE_PHASE_SORT,
+	PROFILE_PHASE_INIT_PLUGIN,
+	PROFILE_PHASE_GET_PLUGIN_FRAME,
+	PROFILE_PHASE_CALIBRATION,
+	PROFILE_PHASE_POWER_LIMIT,
+	PROFILE_PHASES_COUNT
+};
+
+struct LatencyHistogram {
+	uint32_t buckets[PROFILE_BUCKETS_COUNT];
+	uint32_t count;					/*number of recorded samples*/
+	uint64_t maximum;				/*largest recorded sample, in nanoseconds*/
+};
+
+/**
+ * @description: record one duration for a phase
+ * @params phase: one of ProfilePhase
+ * @params nanoseconds: the duration of the phase
+ */
+void recordProfileSample(int phase, uint64_t nanoseconds);
+
+/**
+ * @description: get the value below which the given fraction of the samples of a phase fall
+ * @params phase: one of ProfilePhase
+ * @params quantile: between 0 and 1, e.g. 0.99 for p99
+ * @return: the upper bound of the matching bucket, in nanoseconds, 0 if nothing was recorded
+ */
+uint64_t getProfileQuantile(int phase, double quantile);
+
+/**
+ * @description: print count, p50, p99 and max of every phase that has samples
+ */
+void dumpProfileHistograms(FILE* stream);
+
+/**
+ * @description: forget every recorded sample
+ */
+void resetProfileHistograms();
+
+#ifdef PROFILING_ENABLED
+#define PROFILE_START(phase) uint64_t profileStart_##phase = monotonicNanoseconds()
+#define PROFILE_STOP(phase) recordProfileSample((phase), monotonicNanoseconds() - profileStart_##phase)
+#define PROFILE_DUMP(stream) dumpProfileHistograms(stream)
+#else
+#define PROFILE_START(phase) {}
+#define PROFILE_STOP(phase) {}
+#define PROFILE_DUMP(stream) {}
+#endif
+
+#endif /* INC_PROFILER_H_ */
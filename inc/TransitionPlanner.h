@@ -0,0 +1,36 @@
+/*
+ * TransitionPlanner.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INC_TRANSITIONPLANNER_H_
+#define INC_TRANSITIONPLANNER_H_
+
+#include "AuroraPlugin.h"
+
+#define MINIMUM_TRANSITION_TIME 1
+
+/**
+ * How a phase is shown: a single frame whose fade is interpolated by the controller, then held until the next phase
+ */
+struct TransitionPlan {
+	int transTime;				/*the transTime of every frame of the phase, in multiples of 100ms*/
+	int sleepTime;				/*the sleepTime of the phase, in multiples of 100ms*/
+};
+
+/**
+ * @description: plan one phase so that the controller does the fading instead of the plugin emitting intermediate frames.
+ * The fade is clamped to the phase, so that it is always complete before the next phase starts
+ * @params phaseDuration: how long the phase lasts, fade included, in multiples of 100ms
+ * @params fadeTime: how long the fade into the phase should take, in multiples of 100ms
+ * @params plan: filled with the transTime and the sleepTime to use
+ */
+void planTransition(int phaseDuration, int fadeTime, TransitionPlan* plan);
+
+/**
+ * @description: apply the planned transTime to every frame
+ */
+void applyTransitionPlan(const TransitionPlan* plan, Frame_t* frames, int nFrames);
+
+#endif /* INC_TRANSITIONPLANNER_H_ */
@@ -15,13 +15,32 @@
  */
 
 #include <cmath>
+#include <algorithm>
 
 #include "AuroraPlugin.h"
 #include "LayoutProcessingUtils.h"
+#include "LayoutGeometry.h"
+#include "PanelAdjacency.h"
+#include "PanelDistanceField.h"
+#include "PanelPropagation.h"
+#include "PanelOrdering.h"
+#include "ColorCorrection.h"
+#include "ColorMatrix.h"
+#include "PanelCalibration.h"
+#include "PowerLimiter.h"
+#include "PaletteGradient.h"
+#include "EnergyEnvelope.h"
 #include "ColorUtils.h"
 #include "DataManager.h"
 #include "PluginFeatures.h"
 #include "Logger.h"
+#include "Profiler.h"
+#include "MonotonicClock.h"
+#include "FrameScheduler.h"
+#include "TransitionPlanner.h"
+#include "FrameDeltaFilter.h"
+#include "FrameCompositor.h"
+#include "FrameTrace.h"
 #include "PluginOptionsManager.h"
 #include "PluginOptions.h"
 
@@ -51,6 +70,12 @@ const int MAXIMUM_COLORS_COUNT = GREEN + 1;
 
 const int IGNORED_PANEL_ID = -1;
 
+// While a ripple runs, or the signal follows the sound energy, the phase is cut into frames of this many 100ms.
+const int RIPPLE_FRAME_TIME = 1;
+
+// Sound plugins are called at their own pace, their phases are timed on the clock in units of 100ms.
+const uint64_t TIME_UNIT_NANOSECONDS = 100000000;
+
 /* Data */
 
 LayoutData* layoutData = NULL;
@@ -58,17 +83,95 @@ LayoutData* layoutData = NULL;
 RGB_t* paletteColors = NULL;
 int paletteColorsCount = 0;
 
-FrameSlice_t* frameSlices = NULL;
-int frameSlicesCount = 0;
+LayoutGeometry layoutGeometry;
+PanelAdjacency panelAdjacency;
+
+FrameSliceTable orientedFrameSlices[SNAPPED_ORIENTATIONS_COUNT];
+const FrameSliceTable* frameSlices = NULL;
 
 int transitionTime = 50;
+int fadeTime = 1;
+int backgroundBrightness = 0;
+int backgroundGradientSpace = GRADIENT_RGB;
+int glowRadius = 0;
+int rippleRetention = 0;
+int panelOrder = PANEL_ORDER_SLICES;
+int brightness = 100;
+int gammaCorrection = 0;
+int dither = 0;
+int colorVision = COLOR_VISION_NORMAL;
+int whiteRed = 100;
+int whiteGreen = 100;
+int whiteBlue = 100;
+int powerBudget = FULL_POWER_BUDGET;
+int energyBrightness = 0;
+int energyAttack = 60;
+int energyRelease = 15;
+
+FrameScheduler frameScheduler;
+FrameDeltaFilter frameDeltaFilter;
+FrameCompositor frameCompositor;
+ColorMatrix colorMatrix;
+ColorCorrection colorCorrection;
+PanelCalibration panelCalibration;
+PowerLimiter powerLimiter;
+EnergyEnvelope energyEnvelope;
+PaletteGradient backgroundGradient;
+FrameTraceRecorder frameTraceRecorder;
 
 /* Globals */
 
 vector<RGB_t> colors(MINIMUM_PANELS_COUNT);
 vector<int> colorPanelIds(MINIMUM_PANELS_COUNT);
 
+vector<int> framePanelIds;
+vector<int> colorFrameIndices(MINIMUM_PANELS_COUNT);
+
+PanelDistanceField colorDistanceFields[MAXIMUM_COLORS_COUNT];
+uint8_t glowFalloff[GLOW_FALLOFF_LEVELS_COUNT];
+
+PanelPropagation signalRipple;
+bool rippleActive = false;
+
+uint64_t soundClockTime = 0;
+
+FrameLayer* backgroundLayer = NULL;
+FrameLayer* glowLayer = NULL;
+FrameLayer* rippleLayer = NULL;
+FrameLayer* signalLayer = NULL;
+
 int currentColorIndex = RED;
+int phaseRemainingTime = 0;
+
+/* Helpers */
+
+/**
+ * @description: color one panel of the background, sampling the palette gradient across the layout
+ * @params frameSliceIndex, frameSlicesCount: where the panel is across the layout
+ */
+RGB_t getBackgroundColor(int frameSliceIndex, int frameSlicesCount) {
+    // The nearest entry to where the slice falls.
+    int position = frameSlicesCount > 1 ? (frameSliceIndex * (PALETTE_GRADIENT_SIZE - 1) + (frameSlicesCount - 1) / 2) / (frameSlicesCount - 1) : 0;
+    RGB_t color = samplePaletteGradient(&backgroundGradient, position);
+
+    color.R = color.R * backgroundBrightness / 100;
+    color.G = color.G * backgroundBrightness / 100;
+    color.B = color.B * backgroundBrightness / 100;
+
+    return color;
+}
+
+/**
+ * @description: sound plugins are not told when they are called next, so measure the time since the previous call
+ * @return: the time elapsed since the previous call, in 100ms, the fraction is carried over to the next call
+ */
+int getSoundElapsedTime() {
+    uint64_t elapsedUnits = (monotonicNanoseconds() - soundClockTime) / TIME_UNIT_NANOSECONDS;
+
+    soundClockTime += elapsedUnits * TIME_UNIT_NANOSECONDS;
+
+    return (int)elapsedUnits;
+}
 
 /**
  * @description: Initialize the plugin. Called once, when the plugin is loaded.
@@ -79,15 +182,62 @@ int currentColorIndex = RED;
  *
  */
 void initPlugin() {
+    PROFILE_START(PROFILE_PHASE_INIT_PLUGIN);
+
     /* Load data */
 
+    PROFILE_START(PROFILE_PHASE_GET_LAYOUT_DATA);
     layoutData = getLayoutData();
+    PROFILE_STOP(PROFILE_PHASE_GET_LAYOUT_DATA);
 
     getColorPalette(&paletteColors, &paletteColorsCount);
-    rotateAuroraPanels(layoutData, &layoutData->globalOrientation);
-    getFrameSlicesFromLayoutForTriangle(layoutData, &frameSlices, &frameSlicesCount, layoutData->globalOrientation);
+
+    // Slice the unrotated layout for every orientation, the rotation then only picks a table.
+    PROFILE_START(PROFILE_PHASE_SLICE);
+    buildLayoutGeometry(layoutData, &layoutGeometry);
+    getFrameSlicesForAllOrientations(&layoutGeometry, orientedFrameSlices);
+    PROFILE_STOP(PROFILE_PHASE_SLICE);
+
+    PROFILE_START(PROFILE_PHASE_ADJACENCY);
+    buildPanelAdjacency(&layoutGeometry, &panelAdjacency);
+    PROFILE_STOP(PROFILE_PHASE_ADJACENCY);
+
+    PROFILE_START(PROFILE_PHASE_ROTATE);
+    rotateLayoutGeometry(&layoutGeometry, &layoutData->globalOrientation);
+    PROFILE_STOP(PROFILE_PHASE_ROTATE);
+
+    frameSlices = &orientedFrameSlices[layoutData->globalOrientation / SNAPPED_ORIENTATION_STEP];
+
+    int frameSlicesCount = frameSlices->nFrameSlices;
 
     getOptionValue("transTime", transitionTime);
+    getOptionValue("fadeTime", fadeTime);
+    getOptionValue("backgroundBrightness", backgroundBrightness);
+    getOptionValue("backgroundGradient", backgroundGradientSpace);
+    getOptionValue("glowRadius", glowRadius);
+    getOptionValue("ripple", rippleRetention);
+    getOptionValue("panelOrder", panelOrder);
+    getOptionValue("brightness", brightness);
+    getOptionValue("gamma", gammaCorrection);
+    getOptionValue("dither", dither);
+    getOptionValue("colorVision", colorVision);
+    getOptionValue("whiteRed", whiteRed);
+    getOptionValue("whiteGreen", whiteGreen);
+    getOptionValue("whiteBlue", whiteBlue);
+    getOptionValue("powerBudget", powerBudget);
+    getOptionValue("energyBrightness", energyBrightness);
+    getOptionValue("energyAttack", energyAttack);
+    getOptionValue("energyRelease", energyRelease);
+
+    initFrameScheduler(&frameScheduler, monotonicClockNow, NULL);
+    initFrameDeltaFilter(&frameDeltaFilter, layoutGeometry.nPanels);
+
+    int logLevel = getLogLevel();
+    getOptionValue("logLevel", logLevel);
+    setLogLevel(logLevel);
+
+    LOG_INFO("Layout of %d panels rotated through %d degrees into %d frame slices", layoutGeometry.nPanels, layoutData->globalOrientation, frameSlicesCount);
+    LOG_INFO("%d shared edges between panels", panelAdjacency.nNeighbours / 2);
 
     /* Init default colors */
 
@@ -103,6 +253,8 @@ void initPlugin() {
 
     /* Identify middlest panels */
 
+    PROFILE_START(PROFILE_PHASE_PLACEMENT);
+
     int middleFrameSliceIndex = ceil((frameSlicesCount - 1) / 2);
 
     int minimumMiddleFrameSliceDistance = 31;
@@ -110,12 +262,10 @@ void initPlugin() {
     int middlestFrameSliceIndex = -1;
 
     // Search 3 vertical panels as close to the middle as possible.
-    for (unsigned int frameSliceIndex = 0; frameSliceIndex < frameSlicesCount; frameSliceIndex++) {
-        FrameSlice_t frameSlice = frameSlices[frameSliceIndex];
-        vector<int> panelIds = frameSlice.panelIds;
-        int panelIdsCount = panelIds.size();
+    for (int frameSliceIndex = 0; frameSliceIndex < frameSlicesCount; frameSliceIndex++) {
+        int panelIdsCount = frameSlices->getFrameSliceSize(frameSliceIndex);
 
-        int middleFrameSliceDistance = abs(middleFrameSliceIndex - (int)frameSliceIndex);
+        int middleFrameSliceDistance = abs(middleFrameSliceIndex - frameSliceIndex);
 
         if (panelIdsCount >= MINIMUM_PANELS_COUNT && middleFrameSliceDistance < minimumMiddleFrameSliceDistance) {
             minimumMiddleFrameSliceDistance = middleFrameSliceDistance;
@@ -127,31 +277,38 @@ void initPlugin() {
     // Fallback to the panel(s) right in the middle.
     if (middlestFrameSliceIndex == -1) {
         middlestFrameSliceIndex = middleFrameSliceIndex;
+
+        LOG_WARNING("No frame slice has %d panels, falling back to frame slice %d", MINIMUM_PANELS_COUNT, middlestFrameSliceIndex);
     }
 
+    PROFILE_STOP(PROFILE_PHASE_PLACEMENT);
+
     // Get the middlest panel ids sorted by the vertical position.
-    FrameSlice_t middlestFrameSlice = frameSlices[middlestFrameSliceIndex];
-    vector<int> middlestPanelIds = middlestFrameSlice.panelIds;
-
-    sort(middlestPanelIds.begin(), middlestPanelIds.end(), [](const int firstPanelId, const int secondPanelId) -> bool {
-        double firstPanelY;
-        double secondPanelY;
-
-        for (unsigned int panelIdIndex = 0; panelIdIndex < layoutData->nPanels; panelIdIndex++) {
-            Panel& panel = layoutData->panels[panelIdIndex];
-            int panelId = panel.panelId;
-            Shape* shape = panel.shape;
-            double panelY = shape->getCentroid().y;
-
-            if (panelId == firstPanelId) {
-                firstPanelY = panelY;
-            } else if (panelId == secondPanelId) {
-                secondPanelY = panelY;
-            }
-        }
-        return firstPanelY > secondPanelY;
+    const int* middlestFrameSlicePanelIds = frameSlices->getFrameSlicePanelIds(middlestFrameSliceIndex);
+    int middlestFrameSliceSize = frameSlices->getFrameSliceSize(middlestFrameSliceIndex);
+
+    PROFILE_START(PROFILE_PHASE_SORT);
+    // Look every panel up once, instead of searching the layout on every comparison.
+    vector<int> middlestPanelIndices(middlestFrameSliceSize);
+    vector<int> middlestPositions(middlestFrameSliceSize);
+
+    findGeometryPanelIndices(&layoutGeometry, middlestFrameSlicePanelIds, middlestFrameSliceSize, middlestPanelIndices.data());
+
+    for (int position = 0; position < middlestFrameSliceSize; position++) {
+        middlestPositions[position] = position;
+    }
+
+    sort(middlestPositions.begin(), middlestPositions.end(), [&middlestPanelIndices](const int firstPosition, const int secondPosition) -> bool {
+        return layoutGeometry.centroids.y[middlestPanelIndices[firstPosition]] > layoutGeometry.centroids.y[middlestPanelIndices[secondPosition]];
     });
 
+    vector<int> middlestPanelIds(middlestFrameSliceSize);
+
+    for (int position = 0; position < middlestFrameSliceSize; position++) {
+        middlestPanelIds[position] = middlestFrameSlicePanelIds[middlestPositions[position]];
+    }
+    PROFILE_STOP(PROFILE_PHASE_SORT);
+
     int middlestPanelIdsCount = middlestPanelIds.size();
 
     if (middlestPanelIdsCount >= 3) {
@@ -173,6 +330,120 @@ void initPlugin() {
         colorPanelIds[1] = middlestPanelIds[0];
         colorPanelIds[2] = middlestPanelIds[0];
     }
+
+    LOG_INFO("Signal panels: red %d, yellow %d, green %d", colorPanelIds[RED], colorPanelIds[YELLOW], colorPanelIds[GREEN]);
+
+    /* Prepare the frame layers */
+
+    // The frame order is the slice order, unless the panels are laid along a space-filling curve instead.
+    int framePanelsCount = frameSlices->nPanelIds;
+
+    vector<int> slicePanelIndices(framePanelsCount);
+    vector<int> frameSlicePositions(framePanelsCount);
+
+    findGeometryPanelIndices(&layoutGeometry, frameSlices->panelIds, framePanelsCount, slicePanelIndices.data());
+    orderPanelsAlongCurve(&layoutGeometry, slicePanelIndices.data(), framePanelsCount, panelOrder, frameSlicePositions.data());
+
+    vector<int> framePanelIndices(framePanelsCount);
+    vector<int> sliceFrameIndices(framePanelsCount);
+
+    framePanelIds.resize(framePanelsCount);
+
+    for (int frameIndex = 0; frameIndex < framePanelsCount; frameIndex++) {
+        int slicePosition = frameSlicePositions[frameIndex];
+
+        framePanelIds[frameIndex] = frameSlices->panelIds[slicePosition];
+        framePanelIndices[frameIndex] = slicePanelIndices[slicePosition];
+        sliceFrameIndices[slicePosition] = frameIndex;
+    }
+
+    // Locate the signal panels in the frame order.
+    fill(colorFrameIndices.begin(), colorFrameIndices.end(), 0);
+
+    for (int frameIndex = 0; frameIndex < framePanelsCount; frameIndex++) {
+        for (int colorIndex = RED; colorIndex < MAXIMUM_COLORS_COUNT; colorIndex++) {
+            if (framePanelIds[frameIndex] == colorPanelIds[colorIndex]) {
+                colorFrameIndices[colorIndex] = frameIndex;
+            }
+        }
+    }
+
+    initFrameCompositor(&frameCompositor, framePanelsCount);
+    initColorMatrix(&colorMatrix, colorVision, whiteRed, whiteGreen, whiteBlue);
+    initColorCorrection(&colorCorrection, brightness, gammaCorrection != 0, dither != 0);
+
+    int calibratedPanelsCount = loadPanelCalibration(&panelCalibration, PANEL_CALIBRATION_PATH, framePanelIds.data(), framePanelsCount);
+
+    if (calibratedPanelsCount >= 0) {
+        LOG_INFO("Calibrated %d of %d panels", calibratedPanelsCount, framePanelsCount);
+    }
+
+    initPowerLimiter(&powerLimiter, powerBudget, framePanelsCount);
+
+    backgroundLayer = NULL;
+
+    if (backgroundBrightness > 0) {
+        backgroundLayer = addFrameLayer(&frameCompositor, BLEND_OVER, false);
+
+        // Spread the whole palette across the layout, or the signal colors if there is no palette.
+        const RGB_t* gradientColors = paletteColorsCount > 0 ? paletteColors : colors.data();
+        int gradientColorsCount = paletteColorsCount > 0 ? paletteColorsCount : MAXIMUM_COLORS_COUNT;
+
+        if (updatePaletteGradient(&backgroundGradient, gradientColors, gradientColorsCount, backgroundGradientSpace)) {
+            LOG_DEBUG("Background gradient rebuilt from %d colors", gradientColorsCount);
+        }
+
+        for (int frameSliceIndex = 0; frameSliceIndex < frameSlicesCount; frameSliceIndex++) {
+            RGB_t color = getBackgroundColor(frameSliceIndex, frameSlicesCount);
+
+            for (int slicePosition = frameSlices->offsets[frameSliceIndex]; slicePosition < frameSlices->offsets[frameSliceIndex + 1]; slicePosition++) {
+                setFrameLayerColor(backgroundLayer, sliceFrameIndices[slicePosition], color);
+            }
+        }
+    }
+
+    glowLayer = NULL;
+
+    if (glowRadius > 0) {
+        // Precompute the distances from every signal panel, each frame then only looks them up.
+        vector<int> colorPanelIndices(MAXIMUM_COLORS_COUNT);
+
+        findGeometryPanelIndices(&layoutGeometry, colorPanelIds.data(), MAXIMUM_COLORS_COUNT, colorPanelIndices.data());
+
+        for (int colorIndex = RED; colorIndex < MAXIMUM_COLORS_COUNT; colorIndex++) {
+            if (colorPanelIndices[colorIndex] != -1) {
+                buildPanelDistanceField(&layoutGeometry, &panelAdjacency, colorPanelIndices[colorIndex], framePanelIndices.data(), framePanelsCount, &colorDistanceFields[colorIndex]);
+            }
+        }
+
+        buildGlowFalloff(glowFalloff, glowRadius * EUCLIDEAN_DISTANCE_UNITS_PER_SIDE);
+
+        glowLayer = addFrameLayer(&frameCompositor, BLEND_OVER, true);
+    }
+
+    rippleLayer = NULL;
+    rippleActive = false;
+
+    if (rippleRetention > 0) {
+        initPanelPropagation(&panelAdjacency, framePanelIndices.data(), framePanelsCount, PROPAGATION_RIPPLE, rippleRetention * PROPAGATION_FULL_RETENTION / 100, &signalRipple);
+
+        rippleLayer = addFrameLayer(&frameCompositor, BLEND_ADD, false);
+    }
+
+    signalLayer = addFrameLayer(&frameCompositor, BLEND_OVER, true);
+
+    phaseRemainingTime = 0;
+    soundClockTime = monotonicNanoseconds();
+
+    // The signal follows the loudness of the room.
+    if (energyBrightness) {
+        enableEnergy();
+        initEnergyEnvelope(&energyEnvelope, energyAttack, energyRelease, monotonicNanoseconds());
+    }
+
+    RECORD_TRACE_OPEN(&frameTraceRecorder, framePanelsCount);
+
+    PROFILE_STOP(PROFILE_PHASE_INIT_PLUGIN);
 }
 
 /**
@@ -191,98 +462,108 @@ void initPlugin() {
  * @param sleepTime: specify interval after which this function is called again, NULL if sound visualization plugin
  */
 void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime) {
-    int index = 0;
+    PROFILE_START(PROFILE_PHASE_GET_PLUGIN_FRAME);
 
-    int redPanelAbsoluteFrameIndex = 0;
-    int yellowPanelAbsoluteFrameIndex = 0;
-    int greenPanelAbsoluteFrameIndex = 0;
+    int index = frameCompositor.nPanels;
 
-    // Reset all the panels to black and find the target ones.
-    for (unsigned int frameSliceIndex = 0; frameSliceIndex < frameSlicesCount; frameSliceIndex++) {
-        FrameSlice_t frameSlice = frameSlices[frameSliceIndex];
-        vector<int> panelIds = frameSlice.panelIds;
-        int panelIdsCount = panelIds.size();
+    // The yellow phase is shorter than the red and green ones.
+    int phaseDuration = currentColorIndex == YELLOW ? transitionTime * 0.4 : transitionTime;
 
-        for (unsigned int panelIdIndex = 0; panelIdIndex < panelIdsCount; panelIdIndex++) {
-            int panelId = panelIds[panelIdIndex];
+    // The current color, dimmed with the sound energy, for every layer that shows it.
+    RGB_t signalColor = colors[currentColorIndex];
 
-            frames[index].panelId = panelId;
+    if (energyBrightness) {
+        int level = followEnergyEnvelope(&energyEnvelope, getEnergy(), monotonicNanoseconds());
 
-            frames[index].r = 0;
-            frames[index].g = 0;
-            frames[index].b = 0;
+        signalColor.R = signalColor.R * level / (ENVELOPE_LEVELS_COUNT - 1);
+        signalColor.G = signalColor.G * level / (ENVELOPE_LEVELS_COUNT - 1);
+        signalColor.B = signalColor.B * level / (ENVELOPE_LEVELS_COUNT - 1);
+    }
 
-            frames[index].transTime = 1;
+    if (phaseRemainingTime <= 0) {
+        phaseRemainingTime = phaseDuration;
 
-            if (panelId == colorPanelIds[RED]) {
-                redPanelAbsoluteFrameIndex = index;
-            }
+        // Send a wave out of the signal panel as it changes color.
+        if (rippleLayer) {
+            seedPanelPropagation(&signalRipple, colorFrameIndices[currentColorIndex], signalColor);
+            rippleActive = true;
+        }
+    }
 
-            if (panelId == colorPanelIds[YELLOW] && colorPanelIds[YELLOW] != IGNORED_PANEL_ID) {
-                yellowPanelAbsoluteFrameIndex = index;
-            }
+    // Bleed the current color around its panel.
+    if (glowLayer) {
+        glowFrameLayer(glowLayer, &colorDistanceFields[currentColorIndex], DISTANCE_EUCLIDEAN, glowFalloff, signalColor);
+    }
 
-            if (panelId == colorPanelIds[GREEN]) {
-                greenPanelAbsoluteFrameIndex = index;
-            }
+    // Show the wave as it is, then advance it for the next frame. Once it has died out, one more frame clears it.
+    bool rippleShown = rippleActive;
 
-            index++;
+    if (rippleLayer) {
+        renderPanelPropagation(&signalRipple, rippleLayer);
+
+        if (rippleActive) {
+            rippleActive = stepPanelPropagation(&signalRipple);
         }
     }
 
-    // Set the current color for the respective panel.
-    switch (currentColorIndex) {
-        case RED: {
-            RGB_t color = colors[RED];
+    // A running wave, or a level following the sound, needs short frames, else the whole phase is a single frame.
+    bool shortFrames = rippleShown || energyBrightness;
 
-            frames[redPanelAbsoluteFrameIndex].r = color.R;
-            frames[redPanelAbsoluteFrameIndex].g = color.G;
-            frames[redPanelAbsoluteFrameIndex].b = color.B;
+    // Light the panel of the current color only, on top of the background.
+    clearFrameLayer(signalLayer, index);
+    setFrameLayerColor(signalLayer, colorFrameIndices[currentColorIndex], signalColor);
 
-            frames[redPanelAbsoluteFrameIndex].transTime = 1;
+    composeFrame(&frameCompositor);
+    applyColorMatrix(&colorMatrix, frameCompositor.output, index);
+    // Only sound plugins and short frames come often enough for the dither to blend.
+    applyColorCorrection(&colorCorrection, frameCompositor.output, index, !sleepTime || shortFrames);
 
-            *sleepTime = transitionTime;
+    PROFILE_START(PROFILE_PHASE_CALIBRATION);
+    applyPanelCalibration(&panelCalibration, frameCompositor.output, index);
+    PROFILE_STOP(PROFILE_PHASE_CALIBRATION);
 
-            break;
-        }
-        case YELLOW: {
-            RGB_t color = colors[YELLOW];
+    // Last, so that the cap holds on what the panels are actually sent.
+    PROFILE_START(PROFILE_PHASE_POWER_LIMIT);
+    applyPowerLimiter(&powerLimiter, frameCompositor.output, index);
+    PROFILE_STOP(PROFILE_PHASE_POWER_LIMIT);
 
-            frames[yellowPanelAbsoluteFrameIndex].r = color.R;
-            frames[yellowPanelAbsoluteFrameIndex].g = color.G;
-            frames[yellowPanelAbsoluteFrameIndex].b = color.B;
+    emitComposedFrame(&frameCompositor, framePanelIds.data(), frames);
 
-            frames[yellowPanelAbsoluteFrameIndex].transTime = 1;
+    int frameDuration = shortFrames ? min(RIPPLE_FRAME_TIME, phaseRemainingTime) : phaseRemainingTime;
 
-            *sleepTime = transitionTime * 0.4;
+    // Let the controller cross-fade from the previous frame, instead of driving the fade frame by frame.
+    TransitionPlan transitionPlan;
+    planTransition(frameDuration, fadeTime, &transitionPlan);
+    applyTransitionPlan(&transitionPlan, frames, index);
 
-            break;
-        }
-        case GREEN: {
-            RGB_t color = colors[GREEN];
+    // Keep the long-run cycle on the wall-clock, whatever the call and dispatch overheads.
+    if (sleepTime) {
+        *sleepTime = scheduleNextFrame(&frameScheduler, transitionPlan.sleepTime);
 
-            frames[greenPanelAbsoluteFrameIndex].r = color.R;
-            frames[greenPanelAbsoluteFrameIndex].g = color.G;
-            frames[greenPanelAbsoluteFrameIndex].b = color.B;
+        LOG_DEBUG("Showing color %d on panel %d for %d", currentColorIndex, colorPanelIds[currentColorIndex], *sleepTime);
 
-            frames[greenPanelAbsoluteFrameIndex].transTime = 1;
+        phaseRemainingTime -= transitionPlan.sleepTime;
+    } else {
+        phaseRemainingTime -= getSoundElapsedTime();
+    }
 
-            *sleepTime = transitionTime;
+    // Set the next color once the phase is over.
+    if (phaseRemainingTime <= 0) {
+        do {
+            currentColorIndex++;
 
-            break;
-        }
+            if (currentColorIndex >= MAXIMUM_COLORS_COUNT) {
+                currentColorIndex = RED;
+            }
+        } while (colorPanelIds[currentColorIndex] == IGNORED_PANEL_ID);
     }
 
-    // Set the next color.
-    do {
-        currentColorIndex++;
+    // Only send the panels that change, nothing at all if the whole frame is unchanged.
+    *nFrames = filterUnchangedFrames(&frameDeltaFilter, frames, index);
 
-        if (currentColorIndex >= MAXIMUM_COLORS_COUNT) {
-            currentColorIndex = RED;
-        }
-    } while (colorPanelIds[currentColorIndex] == IGNORED_PANEL_ID);
+    RECORD_TRACE_FRAME(&frameTraceRecorder, frames, *nFrames, sleepTime);
 
-    *nFrames = index;
+    PROFILE_STOP(PROFILE_PHASE_GET_PLUGIN_FRAME);
 }
 
 /**
@@ -290,5 +571,37 @@ void getPluginFrame(Frame_t* frames, int* nFrames, int* sleepTime) {
  * Do all deallocation for memory allocated in initplugin here
  */
 void pluginCleanup() {
-    freeFrameSlices(frameSlices);
+    FrameSchedulerStatistics schedulerStatistics;
+    getFrameSchedulerStatistics(&frameScheduler, &schedulerStatistics);
+
+    LOG_INFO("Scheduler: %d intervals, %d resyncs, mean lateness %dus, rms jitter %dus", schedulerStatistics.intervalsCount, schedulerStatistics.resyncsCount, (int)(schedulerStatistics.meanLateness / 1000), (int)(schedulerStatistics.rmsJitter / 1000));
+
+    for (int orientationIndex = 0; orientationIndex < SNAPPED_ORIENTATIONS_COUNT; orientationIndex++) {
+        freeFrameSliceTable(&orientedFrameSlices[orientationIndex]);
+    }
+
+    frameSlices = NULL;
+    framePanelIds.clear();
+
+    freeLayoutGeometry(&layoutGeometry);
+    freePanelAdjacency(&panelAdjacency);
+    freePanelPropagation(&signalRipple);
+
+    for (int colorIndex = RED; colorIndex < MAXIMUM_COLORS_COUNT; colorIndex++) {
+        freePanelDistanceField(&colorDistanceFields[colorIndex]);
+    }
+
+    freeFrameDeltaFilter(&frameDeltaFilter);
+    freeFrameCompositor(&frameCompositor);
+    freePanelCalibration(&panelCalibration);
+
+    RECORD_TRACE_CLOSE(&frameTraceRecorder);
+
+    backgroundLayer = NULL;
+    glowLayer = NULL;
+    rippleLayer = NULL;
+    signalLayer = NULL;
+
+    dumpLogRecords(stdout);
+    PROFILE_DUMP(stdout);
 }
@@ -0,0 +1,141 @@
+/*
+ * ColorMatrix.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <string.h>
+
+#include "ColorMatrix.h"
+#include "FrameCompositor.h"
+
+/* Constants */
+
+// Daltonization matrices, I + shift * (I - simulation), where the simulation of each deficiency goes through LMS
+// space and the shift moves the lost part of red into green and blue. Baked here so no inverse is ever computed
+// on the controller.
+static const int32_t COLOR_VISION_COEFFICIENTS[COLOR_VISIONS_COUNT][COLOR_MATRIX_SIZE * COLOR_MATRIX_SIZE] = {
+    { 4096,      0,    0,
+         0,   4096,    0,
+         0,      0, 4096 },
+    { 4096,      0,    0,
+      2085,   2011,    0,
+      2529,  -2529, 4096 },
+    { 4096,      0,    0,
+       829,   3267,    0,
+      2119,  -2119, 4096 },
+    { 4096,      0,    0,
+      -567,   4663,    0,
+     13785, -13786, 4096 }
+};
+
+static const int FULL_WHITE_GAIN = 100;
+
+/* Helpers */
+
+/**
+ * Internal helper: drop the fraction bits, rounding to the closest integer
+ */
+static inline int32_t roundColorMatrixProduct(int64_t product) {
+    return (int32_t)((product + (COLOR_MATRIX_ONE >> 1)) >> COLOR_MATRIX_FRACTION_BITS);
+}
+
+/**
+ * Internal helper: whether a matrix is the identity, so that it can be skipped
+ */
+static bool isColorMatrixIdentity(const ColorMatrix* matrix) {
+    for (int row = 0; row < COLOR_MATRIX_SIZE; row++) {
+        for (int column = 0; column < COLOR_MATRIX_SIZE; column++) {
+            if (matrix->coefficients[row * COLOR_MATRIX_SIZE + column] != (row == column ? COLOR_MATRIX_ONE : 0)) {
+                return false;
+            }
+        }
+
+        if (matrix->offsets[row] != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* API */
+
+void setColorMatrixIdentity(ColorMatrix* matrix) {
+    memcpy(matrix->coefficients, COLOR_VISION_COEFFICIENTS[COLOR_VISION_NORMAL], sizeof(matrix->coefficients));
+    memset(matrix->offsets, 0, sizeof(matrix->offsets));
+    matrix->identity = true;
+}
+
+void multiplyColorMatrices(const ColorMatrix* first, const ColorMatrix* then, ColorMatrix* product) {
+    ColorMatrix result;
+
+    for (int row = 0; row < COLOR_MATRIX_SIZE; row++) {
+        int64_t offset = (int64_t)then->offsets[row] << COLOR_MATRIX_FRACTION_BITS;
+
+        for (int column = 0; column < COLOR_MATRIX_SIZE; column++) {
+            int64_t coefficient = 0;
+
+            for (int k = 0; k < COLOR_MATRIX_SIZE; k++) {
+                coefficient += (int64_t)then->coefficients[row * COLOR_MATRIX_SIZE + k] * first->coefficients[k * COLOR_MATRIX_SIZE + column];
+            }
+
+            result.coefficients[row * COLOR_MATRIX_SIZE + column] = roundColorMatrixProduct(coefficient);
+            offset += (int64_t)then->coefficients[row * COLOR_MATRIX_SIZE + column] * first->offsets[column];
+        }
+
+        result.offsets[row] = roundColorMatrixProduct(offset);
+    }
+
+    result.identity = isColorMatrixIdentity(&result);
+    *product = result;
+}
+
+void initColorMatrix(ColorMatrix* matrix, int colorVision, int whiteRed, int whiteGreen, int whiteBlue) {
+    if (colorVision < 0 || colorVision >= COLOR_VISIONS_COUNT) {
+        colorVision = COLOR_VISION_NORMAL;
+    }
+
+    ColorMatrix vision;
+    memcpy(vision.coefficients, COLOR_VISION_COEFFICIENTS[colorVision], sizeof(vision.coefficients));
+    memset(vision.offsets, 0, sizeof(vision.offsets));
+
+    ColorMatrix whiteBalance;
+    setColorMatrixIdentity(&whiteBalance);
+    int gains[COLOR_MATRIX_SIZE] = {whiteRed, whiteGreen, whiteBlue};
+
+    for (int channel = 0; channel < COLOR_MATRIX_SIZE; channel++) {
+        whiteBalance.coefficients[channel * COLOR_MATRIX_SIZE + channel] =
+                (gains[channel] * COLOR_MATRIX_ONE + FULL_WHITE_GAIN / 2) / FULL_WHITE_GAIN;
+    }
+
+    multiplyColorMatrices(&vision, &whiteBalance, matrix);
+}
+
+void applyColorMatrix(const ColorMatrix* matrix, uint8_t* channels, int nPanels) {
+    if (matrix->identity) {
+        return;
+    }
+
+    // Copied out so the compiler keeps them in registers across the loop, which then vectorizes over panels.
+    int32_t m[COLOR_MATRIX_SIZE * COLOR_MATRIX_SIZE];
+    int32_t offsets[COLOR_MATRIX_SIZE];
+    memcpy(m, matrix->coefficients, sizeof(m));
+
+    for (int channel = 0; channel < COLOR_MATRIX_SIZE; channel++) {
+        offsets[channel] = matrix->offsets[channel] + (COLOR_MATRIX_ONE >> 1);
+    }
+
+    uint8_t* __restrict__ output = channels;
+
+    for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+        uint8_t* __restrict__ color = output + panelIndex * FRAME_CHANNELS_COUNT;
+        int32_t R = color[0], G = color[1], B = color[2];
+
+        for (int channel = 0; channel < COLOR_MATRIX_SIZE; channel++) {
+            int32_t level = (m[channel * COLOR_MATRIX_SIZE] * R + m[channel * COLOR_MATRIX_SIZE + 1] * G + m[channel * COLOR_MATRIX_SIZE + 2] * B + offsets[channel]) >> COLOR_MATRIX_FRACTION_BITS;
+
+            color[channel] = level < 0 ? 0 : level > 255 ? 255 : level;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * EnergyEnvelope.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "EnergyEnvelope.h"
+
+/* Constants */
+
+static const int FULL_RATE = 100;
+
+// The peak loses about half of itself every 10s, 200 steps, round(65536 * 2 ^ (-1 / 200)).
+static const uint32_t PEAK_RETENTION = 65309;
+
+// Below this peak the room is taken as silent, rather than amplifying the noise floor to full brightness.
+static const uint32_t MINIMUM_PEAK = 16 << ENVELOPE_FRACTION_BITS;
+
+// After a minute without a call the envelope has long settled, the steps beyond are skipped.
+static const uint64_t MAXIMUM_STEPS_COUNT = 1200;
+
+/* Helpers */
+
+/**
+ * Internal helper: convert a rate in percent, clamped to (0, 100]
+ */
+static uint32_t getEnvelopeRate(int rate) {
+    rate = rate < 1 ? 1 : rate > FULL_RATE ? FULL_RATE : rate;
+
+    return ((uint32_t)rate * ENVELOPE_ONE + FULL_RATE / 2) / FULL_RATE;
+}
+
+/* API */
+
+void initEnergyEnvelope(EnergyEnvelope* envelope, int attack, int release, uint64_t now) {
+    envelope->envelope = 0;
+    envelope->peak = MINIMUM_PEAK;
+    envelope->attack = getEnvelopeRate(attack);
+    envelope->release = getEnvelopeRate(release);
+    envelope->clockTime = now;
+}
+
+int followEnergyEnvelope(EnergyEnvelope* envelope, uint16_t energy, uint64_t now) {
+    uint64_t stepsCount = (now - envelope->clockTime) / ENVELOPE_STEP_NANOSECONDS;
+    envelope->clockTime += stepsCount * ENVELOPE_STEP_NANOSECONDS;
+
+    stepsCount = stepsCount < MAXIMUM_STEPS_COUNT ? stepsCount : MAXIMUM_STEPS_COUNT;
+
+    uint32_t target = (uint32_t)energy << ENVELOPE_FRACTION_BITS;
+    uint32_t current = envelope->envelope;
+    uint32_t peak = envelope->peak;
+
+    for (uint64_t step = 0; step < stepsCount; step++) {
+        if (target > current) {
+            current += (uint32_t)(((uint64_t)(target - current) * envelope->attack) >> ENVELOPE_FRACTION_BITS);
+        } else {
+            current -= (uint32_t)(((uint64_t)(current - target) * envelope->release) >> ENVELOPE_FRACTION_BITS);
+        }
+
+        peak = (uint32_t)(((uint64_t)peak * PEAK_RETENTION) >> ENVELOPE_FRACTION_BITS);
+        peak = peak > current ? peak : current;
+        peak = peak > MINIMUM_PEAK ? peak : MINIMUM_PEAK;
+    }
+
+    envelope->envelope = current;
+    envelope->peak = peak;
+
+    return (int)(((uint64_t)current * (ENVELOPE_LEVELS_COUNT - 1) + peak / 2) / peak);
+}
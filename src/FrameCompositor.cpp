@@ -0,0 +1,166 @@
+/*
+ * FrameCompositor.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "FrameCompositor.h"
+
+/*
+ * The blend kernels run over the packed channels with a unit stride and only widen to 16 bits,
+ * which is the shape the compiler turns into SIMD code on targets that have it.
+ */
+
+/* Helpers */
+
+// x / 255, exact for every product of two bytes.
+static inline uint8_t divideBy255(uint16_t x) {
+    return (uint8_t)((x + 1 + (x >> 8)) >> 8);
+}
+
+static uint8_t clampToByte(int value) {
+    return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+static void blendOver(uint8_t* __restrict__ destination, const uint8_t* __restrict__ source, const uint8_t* __restrict__ alphas, int nPanels, uint8_t opacity) {
+    for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+        uint16_t alpha = alphas ? divideBy255((uint16_t)alphas[panelIndex] * opacity) : opacity;
+        uint16_t inverseAlpha = 255 - alpha;
+
+        for (int channelIndex = 0; channelIndex < FRAME_CHANNELS_COUNT; channelIndex++) {
+            int index = panelIndex * FRAME_CHANNELS_COUNT + channelIndex;
+
+            destination[index] = divideBy255(source[index] * alpha + destination[index] * inverseAlpha);
+        }
+    }
+}
+
+static void blendAdd(uint8_t* __restrict__ destination, const uint8_t* __restrict__ source, int nChannels, uint8_t opacity) {
+    for (int index = 0; index < nChannels; index++) {
+        uint16_t sum = destination[index] + divideBy255((uint16_t)source[index] * opacity);
+
+        destination[index] = sum > 255 ? 255 : sum;
+    }
+}
+
+static void blendMultiply(uint8_t* __restrict__ destination, const uint8_t* __restrict__ source, int nChannels, uint8_t opacity) {
+    uint16_t inverseOpacity = 255 - opacity;
+
+    for (int index = 0; index < nChannels; index++) {
+        // Multiplying by a layer at partial opacity is multiplying by the layer lifted towards white.
+        uint8_t factor = divideBy255((uint16_t)source[index] * opacity) + inverseOpacity;
+
+        destination[index] = divideBy255((uint16_t)destination[index] * factor);
+    }
+}
+
+static void blendMax(uint8_t* __restrict__ destination, const uint8_t* __restrict__ source, int nChannels, uint8_t opacity) {
+    for (int index = 0; index < nChannels; index++) {
+        uint8_t value = divideBy255((uint16_t)source[index] * opacity);
+
+        destination[index] = value > destination[index] ? value : destination[index];
+    }
+}
+
+/* API */
+
+void initFrameCompositor(FrameCompositor* compositor, int nPanels) {
+    freeFrameCompositor(compositor);
+
+    compositor->nPanels = nPanels;
+    compositor->output = new uint8_t[nPanels * FRAME_CHANNELS_COUNT]();
+}
+
+FrameLayer* addFrameLayer(FrameCompositor* compositor, int blendMode, bool withAlphas) {
+    if (compositor->nLayers >= MAXIMUM_FRAME_LAYERS_COUNT) {
+        return NULL;
+    }
+
+    FrameLayer* layer = &compositor->layers[compositor->nLayers++];
+
+    layer->channels = new uint8_t[compositor->nPanels * FRAME_CHANNELS_COUNT]();
+    layer->alphas = withAlphas ? new uint8_t[compositor->nPanels]() : NULL;
+    layer->blendMode = blendMode;
+    layer->opacity = 255;
+    layer->enabled = true;
+
+    return layer;
+}
+
+void setFrameLayerColor(FrameLayer* layer, int frameIndex, const RGB_t& color) {
+    uint8_t* channels = layer->channels + frameIndex * FRAME_CHANNELS_COUNT;
+
+    channels[0] = clampToByte(color.R);
+    channels[1] = clampToByte(color.G);
+    channels[2] = clampToByte(color.B);
+
+    if (layer->alphas) {
+        layer->alphas[frameIndex] = 255;
+    }
+}
+
+void clearFrameLayer(FrameLayer* layer, int nPanels) {
+    memset(layer->channels, 0, nPanels * FRAME_CHANNELS_COUNT);
+
+    if (layer->alphas) {
+        memset(layer->alphas, 0, nPanels);
+    }
+}
+
+void composeFrame(FrameCompositor* compositor) {
+    int nChannels = compositor->nPanels * FRAME_CHANNELS_COUNT;
+
+    memset(compositor->output, 0, nChannels);
+
+    for (int layerIndex = 0; layerIndex < compositor->nLayers; layerIndex++) {
+        const FrameLayer& layer = compositor->layers[layerIndex];
+
+        if (!layer.enabled || layer.opacity == 0) {
+            continue;
+        }
+
+        switch (layer.blendMode) {
+            case BLEND_OVER:
+                blendOver(compositor->output, layer.channels, layer.alphas, compositor->nPanels, layer.opacity);
+                break;
+            case BLEND_ADD:
+                blendAdd(compositor->output, layer.channels, nChannels, layer.opacity);
+                break;
+            case BLEND_MULTIPLY:
+                blendMultiply(compositor->output, layer.channels, nChannels, layer.opacity);
+                break;
+            case BLEND_MAX:
+                blendMax(compositor->output, layer.channels, nChannels, layer.opacity);
+                break;
+        }
+    }
+}
+
+void emitComposedFrame(const FrameCompositor* compositor, const int* panelIds, Frame_t* frames) {
+    const uint8_t* channels = compositor->output;
+
+    for (int frameIndex = 0; frameIndex < compositor->nPanels; frameIndex++) {
+        frames[frameIndex].panelId = panelIds[frameIndex];
+        frames[frameIndex].r = channels[0];
+        frames[frameIndex].g = channels[1];
+        frames[frameIndex].b = channels[2];
+
+        channels += FRAME_CHANNELS_COUNT;
+    }
+}
+
+void freeFrameCompositor(FrameCompositor* compositor) {
+    delete [] compositor->output;
+
+    for (int layerIndex = 0; layerIndex < compositor->nLayers; layerIndex++) {
+        delete [] compositor->layers[layerIndex].channels;
+        delete [] compositor->layers[layerIndex].alphas;
+    }
+
+    compositor->nPanels = 0;
+    compositor->output = NULL;
+    compositor->nLayers = 0;
+}
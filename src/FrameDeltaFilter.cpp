@@ -0,0 +1,91 @@
+/*
+ * FrameDeltaFilter.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <stddef.h>
+
+#include "FrameDeltaFilter.h"
+
+/* Helpers */
+
+static uint32_t packFrameColor(const Frame_t& frame) {
+    return ((uint32_t)(frame.r & 0xFF) << 16) | ((uint32_t)(frame.g & 0xFF) << 8) | (uint32_t)(frame.b & 0xFF);
+}
+
+static bool isSamePanelOrder(const FrameDeltaFilter* filter, const Frame_t* frames, int nFrames) {
+    if (nFrames != filter->nPanels) {
+        return false;
+    }
+
+    for (int index = 0; index < nFrames; index++) {
+        if (frames[index].panelId != filter->panelIds[index]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* API */
+
+void initFrameDeltaFilter(FrameDeltaFilter* filter, int nPanels) {
+    freeFrameDeltaFilter(filter);
+
+    filter->capacity = nPanels;
+    filter->nPanels = 0;
+    filter->panelIds = new int[nPanels];
+    filter->colors = new uint32_t[nPanels];
+    filter->valid = false;
+}
+
+void invalidateFrameDeltaFilter(FrameDeltaFilter* filter) {
+    filter->valid = false;
+}
+
+int filterUnchangedFrames(FrameDeltaFilter* filter, Frame_t* frames, int nFrames) {
+    if (!filter->valid || !isSamePanelOrder(filter, frames, nFrames)) {
+        // Only grows, so a short frame never makes the next full one reallocate.
+        if (nFrames > filter->capacity) {
+            initFrameDeltaFilter(filter, nFrames);
+        }
+
+        filter->nPanels = nFrames;
+
+        for (int index = 0; index < nFrames; index++) {
+            filter->panelIds[index] = frames[index].panelId;
+            filter->colors[index] = packFrameColor(frames[index]);
+        }
+
+        filter->valid = true;
+
+        return nFrames;
+    }
+
+    int changedCount = 0;
+
+    for (int index = 0; index < nFrames; index++) {
+        uint32_t color = packFrameColor(frames[index]);
+
+        if (color == filter->colors[index]) {
+            continue;
+        }
+
+        filter->colors[index] = color;
+        frames[changedCount++] = frames[index];
+    }
+
+    return changedCount;
+}
+
+void freeFrameDeltaFilter(FrameDeltaFilter* filter) {
+    delete [] filter->panelIds;
+    delete [] filter->colors;
+
+    filter->capacity = 0;
+    filter->nPanels = 0;
+    filter->panelIds = NULL;
+    filter->colors = NULL;
+    filter->valid = false;
+}
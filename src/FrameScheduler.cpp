@@ -0,0 +1,112 @@
+/*
+ * FrameScheduler.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <stddef.h>
+
+#include "FrameScheduler.h"
+#include "MonotonicClock.h"
+#include "IntegerMath.h"
+
+/* Constants */
+
+// Beyond this many nominal periods of delay, catching up would mean a burst of short frames, so start over instead.
+static const int RESYNC_LATE_PERIODS_COUNT = 2;
+
+// A call this early did not honour the previous sleep time at all, e.g. the host called again right away.
+static const int RESYNC_EARLY_PERIOD_FRACTION = 2;
+
+/* Helpers */
+
+static void recordLateness(FrameScheduler* scheduler, int64_t lateness) {
+    int64_t latenessMicroseconds = lateness / 1000;
+
+    if (scheduler->intervalsCount == 0 || lateness > scheduler->maximumLateness) {
+        scheduler->maximumLateness = lateness;
+    }
+
+    if (scheduler->intervalsCount == 0 || lateness < scheduler->minimumLateness) {
+        scheduler->minimumLateness = lateness;
+    }
+
+    scheduler->latenessSum += lateness;
+    scheduler->squaredLatenessSum += (uint64_t)(latenessMicroseconds * latenessMicroseconds);
+    scheduler->intervalsCount++;
+}
+
+/* API */
+
+uint64_t monotonicClockNow(void* /*context*/) {
+    return monotonicNanoseconds();
+}
+
+uint64_t virtualClockNow(void* context) {
+    return ((VirtualClock*)context)->nanoseconds;
+}
+
+void initFrameScheduler(FrameScheduler* scheduler, SchedulerClock clock, void* clockContext) {
+    scheduler->clock = clock;
+    scheduler->clockContext = clockContext;
+    scheduler->started = false;
+    scheduler->targetTime = 0;
+    scheduler->period = 0;
+    scheduler->intervalsCount = 0;
+    scheduler->resyncsCount = 0;
+    scheduler->latenessSum = 0;
+    scheduler->squaredLatenessSum = 0;
+    scheduler->maximumLateness = 0;
+    scheduler->minimumLateness = 0;
+}
+
+int scheduleNextFrame(FrameScheduler* scheduler, int nominalSleepTime) {
+    uint64_t now = scheduler->clock(scheduler->clockContext);
+    uint64_t period = (uint64_t)nominalSleepTime * SLEEP_TIME_UNIT_NANOSECONDS;
+
+    if (!scheduler->started) {
+        scheduler->started = true;
+        scheduler->targetTime = now;
+    } else {
+        int64_t lateness = (int64_t)(now - scheduler->targetTime);
+
+        // Judge the call against the period that was asked for, the new one may be different.
+        uint64_t previousPeriod = scheduler->period;
+
+        if (lateness > (int64_t)(RESYNC_LATE_PERIODS_COUNT * previousPeriod) || -lateness > (int64_t)(previousPeriod / RESYNC_EARLY_PERIOD_FRACTION)) {
+            scheduler->targetTime = now;
+            scheduler->resyncsCount++;
+        } else {
+            recordLateness(scheduler, lateness);
+        }
+    }
+
+    scheduler->targetTime += period;
+    scheduler->period = period;
+
+    if (scheduler->targetTime <= now) {
+        return MINIMUM_SLEEP_TIME;
+    }
+
+    // Round to the closest unit, the remainder is absorbed by the next correction.
+    int sleepTime = (int)((scheduler->targetTime - now + SLEEP_TIME_UNIT_NANOSECONDS / 2) / SLEEP_TIME_UNIT_NANOSECONDS);
+
+    return sleepTime < MINIMUM_SLEEP_TIME ? MINIMUM_SLEEP_TIME : sleepTime;
+}
+
+void getFrameSchedulerStatistics(const FrameScheduler* scheduler, FrameSchedulerStatistics* statistics) {
+    statistics->intervalsCount = scheduler->intervalsCount;
+    statistics->resyncsCount = scheduler->resyncsCount;
+    statistics->maximumLateness = scheduler->maximumLateness;
+    statistics->minimumLateness = scheduler->minimumLateness;
+
+    if (scheduler->intervalsCount == 0) {
+        statistics->meanLateness = 0;
+        statistics->rmsJitter = 0;
+
+        return;
+    }
+
+    statistics->meanLateness = scheduler->latenessSum / (int64_t)scheduler->intervalsCount;
+    statistics->rmsJitter = integerSquareRoot(scheduler->squaredLatenessSum / scheduler->intervalsCount) * 1000;
+}
@@ -0,0 +1,48 @@
+/*
+ * FrameSliceTable.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "FrameSliceTable.h"
+
+void allocateFrameSliceTable(FrameSliceTable* table, int nFrameSlices, int nPanelIds) {
+    freeFrameSliceTable(table);
+
+    // One allocation for both arrays, the offsets first.
+    table->offsets = new int[nFrameSlices + 1 + nPanelIds];
+    table->panelIds = table->offsets + nFrameSlices + 1;
+    table->nFrameSlices = nFrameSlices;
+    table->nPanelIds = nPanelIds;
+}
+
+void buildFrameSliceTable(const FrameSlice_t* frameSlices, int nFrameSlices, FrameSliceTable* table) {
+    int nPanelIds = 0;
+
+    for (int frameSliceIndex = 0; frameSliceIndex < nFrameSlices; frameSliceIndex++) {
+        nPanelIds += frameSlices[frameSliceIndex].panelIds.size();
+    }
+
+    allocateFrameSliceTable(table, nFrameSlices, nPanelIds);
+
+    int panelIdIndex = 0;
+
+    for (int frameSliceIndex = 0; frameSliceIndex < nFrameSlices; frameSliceIndex++) {
+        table->offsets[frameSliceIndex] = panelIdIndex;
+
+        for (int panelId : frameSlices[frameSliceIndex].panelIds) {
+            table->panelIds[panelIdIndex++] = panelId;
+        }
+    }
+
+    table->offsets[nFrameSlices] = panelIdIndex;
+}
+
+void freeFrameSliceTable(FrameSliceTable* table) {
+    delete [] table->offsets;
+
+    table->nFrameSlices = 0;
+    table->nPanelIds = 0;
+    table->offsets = NULL;
+    table->panelIds = NULL;
+}
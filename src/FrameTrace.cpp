@@ -0,0 +1,125 @@
+/*
+ * FrameTrace.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <string.h>
+
+#include "FrameTrace.h"
+#include "MonotonicClock.h"
+
+/* Constants */
+
+static const int FRAME_TRACE_FIELDS_COUNT = 5;
+static const int FRAME_TRACE_MAXIMUM_ENTRY_SIZE = 1 + FRAME_TRACE_FIELDS_COUNT * sizeof(int32_t);
+
+/* Helpers */
+
+static uint8_t* writeField(uint8_t* cursor, int32_t value) {
+    memcpy(cursor, &value, sizeof(value));
+
+    return cursor + sizeof(value);
+}
+
+/* Recording */
+
+bool openFrameTraceRecorder(FrameTraceRecorder* recorder, const char* path, int maximumFrames) {
+    recorder->file = fopen(path, "wb");
+
+    if (!recorder->file) {
+        return false;
+    }
+
+    recorder->maximumFrames = maximumFrames;
+    recorder->previousFrames = new Frame_t[maximumFrames]();
+    recorder->previousFramesCount = 0;
+    recorder->encodeBuffer = new uint8_t[maximumFrames * FRAME_TRACE_MAXIMUM_ENTRY_SIZE];
+    recorder->startTime = 0;
+    recorder->started = false;
+
+    FrameTraceHeader header;
+    header.magic = FRAME_TRACE_MAGIC;
+    header.version = FRAME_TRACE_VERSION;
+    header.maximumFrames = maximumFrames;
+    header.reserved = 0;
+
+    fwrite(&header, sizeof(header), 1, recorder->file);
+
+    return true;
+}
+
+void recordTraceFrame(FrameTraceRecorder* recorder, const Frame_t* frames, int nFrames, const int* sleepTime) {
+    if (!recorder->file || nFrames > recorder->maximumFrames) {
+        return;
+    }
+
+    uint64_t now = monotonicNanoseconds();
+
+    if (!recorder->started) {
+        recorder->started = true;
+        recorder->startTime = now;
+    }
+
+    uint8_t* cursor = recorder->encodeBuffer;
+
+    for (int index = 0; index < nFrames; index++) {
+        const Frame_t& frame = frames[index];
+        Frame_t& previous = recorder->previousFrames[index];
+
+        uint8_t* mask = cursor++;
+        *mask = 0;
+
+        if (index >= recorder->previousFramesCount || frame.panelId != previous.panelId) {
+            *mask |= FRAME_TRACE_FIELD_PANEL_ID;
+            cursor = writeField(cursor, frame.panelId);
+        }
+        if (index >= recorder->previousFramesCount || frame.r != previous.r) {
+            *mask |= FRAME_TRACE_FIELD_R;
+            cursor = writeField(cursor, frame.r);
+        }
+        if (index >= recorder->previousFramesCount || frame.g != previous.g) {
+            *mask |= FRAME_TRACE_FIELD_G;
+            cursor = writeField(cursor, frame.g);
+        }
+        if (index >= recorder->previousFramesCount || frame.b != previous.b) {
+            *mask |= FRAME_TRACE_FIELD_B;
+            cursor = writeField(cursor, frame.b);
+        }
+        if (index >= recorder->previousFramesCount || frame.transTime != previous.transTime) {
+            *mask |= FRAME_TRACE_FIELD_TRANS_TIME;
+            cursor = writeField(cursor, frame.transTime);
+        }
+
+        previous = frame;
+    }
+
+    // Entries past the end of a shorter record are kept, so that they can still be delta-encoded against later.
+    if (nFrames > recorder->previousFramesCount) {
+        recorder->previousFramesCount = nFrames;
+    }
+
+    FrameTraceRecordHeader header;
+    header.timestamp = now - recorder->startTime;
+    header.sleepTime = sleepTime ? *sleepTime : -1;
+    header.nFrames = nFrames;
+    header.payloadSize = cursor - recorder->encodeBuffer;
+    header.reserved = 0;
+
+    fwrite(&header, sizeof(header), 1, recorder->file);
+    fwrite(recorder->encodeBuffer, 1, header.payloadSize, recorder->file);
+}
+
+void closeFrameTraceRecorder(FrameTraceRecorder* recorder) {
+    if (recorder->file) {
+        fclose(recorder->file);
+    }
+
+    delete [] recorder->previousFrames;
+    delete [] recorder->encodeBuffer;
+
+    recorder->file = NULL;
+    recorder->previousFrames = NULL;
+    recorder->encodeBuffer = NULL;
+    recorder->previousFramesCount = 0;
+}
@@ -0,0 +1,447 @@
+/*
+ * LayoutGeometry.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <sys/mman.h>
+
+#include "LayoutGeometry.h"
+
+/* Constants */
+
+// sin(index * 30 degrees), spelled out so that the multiples of 90 degrees are exactly 0 and 1 and 30 degrees is exactly 0.5.
+static const coord_t SNAPPED_SINES[SNAPPED_ORIENTATIONS_COUNT] = {
+    COORD_FROM_RATIO(0.0),  COORD_FROM_RATIO(0.5),  COORD_FROM_RATIO(0.86602540378443864676),
+    COORD_FROM_RATIO(1.0),  COORD_FROM_RATIO(0.86602540378443864676),  COORD_FROM_RATIO(0.5),
+    COORD_FROM_RATIO(0.0),  COORD_FROM_RATIO(-0.5), COORD_FROM_RATIO(-0.86602540378443864676),
+    COORD_FROM_RATIO(-1.0), COORD_FROM_RATIO(-0.86602540378443864676), COORD_FROM_RATIO(-0.5)
+};
+
+static const double TRIANGLE_GRID_SPACING_ALIGNED = 0.5;
+static const double TRIANGLE_GRID_SPACING_UNALIGNED = 0.28867513459481288225; // sqrt(3) / 6
+
+static const size_t ARENA_ALIGNMENT = sizeof(double);
+
+/* Helpers */
+
+static size_t alignArenaSize(size_t size) {
+    return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+template <typename T>
+static T* carveArena(char** cursor, int count) {
+    T* array = reinterpret_cast<T*>(*cursor);
+
+    *cursor += alignArenaSize(sizeof(T) * count);
+
+    return array;
+}
+
+static void getOrientationSineCosine(int orientation, coord_t* sine, coord_t* cosine) {
+    if (orientation % SNAPPED_ORIENTATION_STEP == 0) {
+        int orientationIndex = snapOrientationIndex(orientation);
+
+        *sine = SNAPPED_SINES[orientationIndex];
+        *cosine = SNAPPED_SINES[(orientationIndex + 3) % SNAPPED_ORIENTATIONS_COUNT];
+    } else {
+        double radians = orientation * M_PI / 180;
+
+        *sine = COORD_FROM_RATIO(sin(radians));
+        *cosine = COORD_FROM_RATIO(cos(radians));
+    }
+}
+
+static int positiveModulo(int value, int modulus) {
+    int remainder = value % modulus;
+
+    return remainder < 0 ? remainder + modulus : remainder;
+}
+
+/**
+ * Internal helper: sort the lit panels by the slice their projection snaps to, then by layout order,
+ * and sweep the sorted run into the table. The scratch buffers hold at least nPanels elements
+ */
+static void sweepProjections(const LayoutGeometry* geometry, const coord_t* projections, coord_t sliceWidth, int* sliceIndices, int* order, FrameSliceTable* frameSlices) {
+    int nLitPanels = 0;
+
+    for (int panelIndex = 0; panelIndex < geometry->nPanels; panelIndex++) {
+        if (geometry->shapeTypes[panelIndex] != SHAPE_RHYTHM) {
+            order[nLitPanels++] = panelIndex;
+        }
+    }
+
+    if (nLitPanels == 0) {
+        allocateFrameSliceTable(frameSlices, 0, 0);
+        frameSlices->offsets[0] = 0;
+
+        return;
+    }
+
+    coord_t minimum = projections[order[0]];
+
+    for (int orderIndex = 1; orderIndex < nLitPanels; orderIndex++) {
+        minimum = std::min(minimum, projections[order[orderIndex]]);
+    }
+
+    for (int orderIndex = 0; orderIndex < nLitPanels; orderIndex++) {
+        int panelIndex = order[orderIndex];
+
+        sliceIndices[panelIndex] = coordDivideRounded(projections[panelIndex] - minimum, sliceWidth);
+    }
+
+    // Sort by slice, then by layout order, so that the sweep sees every slice as one run.
+    std::sort(order, order + nLitPanels, [sliceIndices](int firstPanelIndex, int secondPanelIndex) -> bool {
+        if (sliceIndices[firstPanelIndex] != sliceIndices[secondPanelIndex]) {
+            return sliceIndices[firstPanelIndex] < sliceIndices[secondPanelIndex];
+        }
+        return firstPanelIndex < secondPanelIndex;
+    });
+
+    int frameSlicesCount = sliceIndices[order[nLitPanels - 1]] + 1;
+
+    allocateFrameSliceTable(frameSlices, frameSlicesCount, nLitPanels);
+
+    // Sweep, opening every slice up to the one of the current panel, including the empty ones.
+    int openedFrameSlicesCount = 0;
+
+    for (int orderIndex = 0; orderIndex < nLitPanels; orderIndex++) {
+        int panelIndex = order[orderIndex];
+
+        while (openedFrameSlicesCount <= sliceIndices[panelIndex]) {
+            frameSlices->offsets[openedFrameSlicesCount++] = orderIndex;
+        }
+
+        frameSlices->panelIds[orderIndex] = geometry->panelIds[panelIndex];
+    }
+
+    frameSlices->offsets[frameSlicesCount] = nLitPanels;
+}
+
+/* API */
+
+int snapOrientationIndex(int angle_degrees) {
+    int roundedAngle = angle_degrees + SNAPPED_ORIENTATION_STEP / 2;
+    int index = roundedAngle / SNAPPED_ORIENTATION_STEP;
+
+    // Integer division truncates towards zero, floor it instead.
+    if (roundedAngle < 0 && roundedAngle % SNAPPED_ORIENTATION_STEP != 0) {
+        index--;
+    }
+
+    index %= SNAPPED_ORIENTATIONS_COUNT;
+
+    if (index < 0) {
+        index += SNAPPED_ORIENTATIONS_COUNT;
+    }
+
+    return index;
+}
+
+size_t getLayoutGeometryArenaSize(int nPanels, int nVertices) {
+    return 3 * alignArenaSize(sizeof(int) * nPanels) +
+           2 * alignArenaSize(sizeof(coord_t) * nPanels) +
+           alignArenaSize(sizeof(int) * (nPanels + 1)) +
+           2 * alignArenaSize(sizeof(coord_t) * nVertices);
+}
+
+void carveLayoutGeometry(LayoutGeometry* geometry, char* arena, int nPanels, int nVertices) {
+    char* cursor = arena;
+
+    coord_t* centroidsX = carveArena<coord_t>(&cursor, nPanels);
+    coord_t* centroidsY = carveArena<coord_t>(&cursor, nPanels);
+    coord_t* verticesX = carveArena<coord_t>(&cursor, nVertices);
+    coord_t* verticesY = carveArena<coord_t>(&cursor, nVertices);
+
+    geometry->centroids = PointArray(centroidsX, centroidsY, nPanels);
+    geometry->vertices = PointArray(verticesX, verticesY, nVertices);
+    geometry->panelIds = carveArena<int>(&cursor, nPanels);
+    geometry->shapeTypes = carveArena<int>(&cursor, nPanels);
+    geometry->orientations = carveArena<int>(&cursor, nPanels);
+    geometry->vertexOffsets = carveArena<int>(&cursor, nPanels + 1);
+
+    geometry->nPanels = nPanels;
+}
+
+void allocateLayoutGeometry(LayoutGeometry* geometry, int nPanels, int nVertices) {
+    freeLayoutGeometry(geometry);
+
+    geometry->arena = new char[getLayoutGeometryArenaSize(nPanels, nVertices)];
+
+    carveLayoutGeometry(geometry, geometry->arena, nPanels, nVertices);
+}
+
+void buildLayoutGeometry(LayoutData* layoutData, LayoutGeometry* geometry) {
+    int nPanels = layoutData->nPanels;
+    int nVertices = 0;
+
+    for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+        nVertices += layoutData->panels[panelIndex].shape->nVertices;
+    }
+
+    allocateLayoutGeometry(geometry, nPanels, nVertices);
+
+    coord_t* centroidsX = geometry->centroids.x;
+    coord_t* centroidsY = geometry->centroids.y;
+    coord_t* verticesX = geometry->vertices.x;
+    coord_t* verticesY = geometry->vertices.y;
+
+    int vertexIndex = 0;
+
+    for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+        Panel& panel = layoutData->panels[panelIndex];
+        Shape* shape = panel.shape;
+        const Point& centroid = shape->getCentroid();
+
+        geometry->panelIds[panelIndex] = panel.panelId;
+        geometry->shapeTypes[panelIndex] = shape->shapeType;
+        geometry->orientations[panelIndex] = shape->getOrientation();
+        centroidsX[panelIndex] = coordFromLength(centroid.x);
+        centroidsY[panelIndex] = coordFromLength(centroid.y);
+        geometry->vertexOffsets[panelIndex] = vertexIndex;
+
+        for (int shapeVertexIndex = 0; shapeVertexIndex < shape->nVertices; shapeVertexIndex++) {
+            verticesX[vertexIndex] = coordFromLength(shape->vertices[shapeVertexIndex].x);
+            verticesY[vertexIndex] = coordFromLength(shape->vertices[shapeVertexIndex].y);
+
+            vertexIndex++;
+        }
+    }
+
+    geometry->vertexOffsets[nPanels] = vertexIndex;
+}
+
+void rotateLayoutGeometry(LayoutGeometry* geometry, int* angle_degrees) {
+    int orientationIndex = snapOrientationIndex(*angle_degrees);
+    int snappedAngle = orientationIndex * SNAPPED_ORIENTATION_STEP;
+
+    *angle_degrees = snappedAngle;
+
+    if (orientationIndex == 0) {
+        return;
+    }
+
+    coord_t sine = SNAPPED_SINES[orientationIndex];
+    coord_t cosine = SNAPPED_SINES[(orientationIndex + 3) % SNAPPED_ORIENTATIONS_COUNT];
+
+    rotatePointArray(geometry->centroids, sine, cosine);
+    rotatePointArray(geometry->vertices, sine, cosine);
+
+    for (int panelIndex = 0; panelIndex < geometry->nPanels; panelIndex++) {
+        geometry->orientations[panelIndex] = (geometry->orientations[panelIndex] + snappedAngle) % 360;
+    }
+
+    geometry->totalRotation = (geometry->totalRotation + snappedAngle) % 360;
+}
+
+void getFrameSlicesFromGeometryForTriangle(const LayoutGeometry* geometry, FrameSliceTable* frameSlices) {
+    if (geometry->nPanels == 0) {
+        allocateFrameSliceTable(frameSlices, 0, 0);
+        frameSlices->offsets[0] = 0;
+
+        return;
+    }
+
+    coord_t spacing = COORD_FROM_SIDE_LENGTHS(geometry->totalRotation % 60 == 0 ? TRIANGLE_GRID_SPACING_ALIGNED : TRIANGLE_GRID_SPACING_UNALIGNED);
+
+    Vec2 minimum;
+    Vec2 maximum;
+
+    boundsOfPointArray(geometry->centroids, &minimum, &maximum);
+
+    int frameSlicesCount = coordDivideRounded(maximum.x - minimum.x, spacing) + 1;
+
+    allocateFrameSliceTable(frameSlices, frameSlicesCount, geometry->nPanels);
+
+    int* offsets = frameSlices->offsets;
+
+    for (int frameSliceIndex = 0; frameSliceIndex <= frameSlicesCount; frameSliceIndex++) {
+        offsets[frameSliceIndex] = 0;
+    }
+
+    // Count the panels of every slice, shifted by one so that the prefix sum gives the starts.
+    for (int panelIndex = 0; panelIndex < geometry->nPanels; panelIndex++) {
+        offsets[coordDivideRounded(geometry->centroids.x[panelIndex] - minimum.x, spacing) + 1]++;
+    }
+
+    for (int frameSliceIndex = 0; frameSliceIndex < frameSlicesCount; frameSliceIndex++) {
+        offsets[frameSliceIndex + 1] += offsets[frameSliceIndex];
+    }
+
+    // Fill each slice in the layout order, using the starts as cursors and restoring them afterwards.
+    for (int panelIndex = 0; panelIndex < geometry->nPanels; panelIndex++) {
+        int frameSliceIndex = coordDivideRounded(geometry->centroids.x[panelIndex] - minimum.x, spacing);
+
+        frameSlices->panelIds[offsets[frameSliceIndex]++] = geometry->panelIds[panelIndex];
+    }
+
+    for (int frameSliceIndex = frameSlicesCount; frameSliceIndex > 0; frameSliceIndex--) {
+        offsets[frameSliceIndex] = offsets[frameSliceIndex - 1];
+    }
+
+    offsets[0] = 0;
+}
+
+coord_t getFrameSliceWidth(const LayoutGeometry* geometry, int angle_degrees) {
+    bool hasTriangles = false;
+
+    for (int panelIndex = 0; panelIndex < geometry->nPanels; panelIndex++) {
+        if (geometry->shapeTypes[panelIndex] == SHAPE_TRIANGLE) {
+            hasTriangles = true;
+            break;
+        }
+    }
+
+    // The angle between the sweep direction and the grid the panels were laid on.
+    int relativeAngle = geometry->totalRotation - angle_degrees;
+
+    if (hasTriangles) {
+        return COORD_FROM_SIDE_LENGTHS(positiveModulo(relativeAngle, 60) == 0 ? TRIANGLE_GRID_SPACING_ALIGNED : TRIANGLE_GRID_SPACING_UNALIGNED);
+    }
+
+    // Squares project one side length apart along the axis closest to the direction.
+    double radians = positiveModulo(relativeAngle, 90) * M_PI / 180;
+
+    return COORD_FROM_SIDE_LENGTHS(std::max(fabs(cos(radians)), fabs(sin(radians))));
+}
+
+void getFrameSlicesFromGeometry(const LayoutGeometry* geometry, int angle_degrees, coord_t sliceWidth, FrameSliceTable* frameSlices) {
+    int nPanels = geometry->nPanels;
+
+    coord_t* projections = new coord_t[nPanels];
+    int* sliceIndices = new int[nPanels];
+    int* order = new int[nPanels];
+
+    coord_t sine;
+    coord_t cosine;
+
+    getOrientationSineCosine(angle_degrees, &sine, &cosine);
+    projectPointArray(geometry->centroids, sine, cosine, projections);
+
+    sweepProjections(geometry, projections, sliceWidth, sliceIndices, order, frameSlices);
+
+    delete [] projections;
+    delete [] sliceIndices;
+    delete [] order;
+}
+
+void getFrameSlicesForAllOrientations(const LayoutGeometry* geometry, FrameSliceTable* frameSlices) {
+    int nPanels = geometry->nPanels;
+
+    coord_t* projections = new coord_t[nPanels];
+    int* sliceIndices = new int[nPanels];
+    int* order = new int[nPanels];
+
+    // Rotating through an angle then sweeping along x is sweeping the unrotated geometry along the opposite angle.
+    for (int orientationIndex = 0; orientationIndex < SNAPPED_ORIENTATIONS_COUNT / 2; orientationIndex++) {
+        int oppositeOrientationIndex = orientationIndex + SNAPPED_ORIENTATIONS_COUNT / 2;
+        int angle = -orientationIndex * SNAPPED_ORIENTATION_STEP;
+        int oppositeAngle = -oppositeOrientationIndex * SNAPPED_ORIENTATION_STEP;
+
+        coord_t sine;
+        coord_t cosine;
+
+        getOrientationSineCosine(angle, &sine, &cosine);
+        projectPointArray(geometry->centroids, sine, cosine, projections);
+
+        sweepProjections(geometry, projections, getFrameSliceWidth(geometry, angle), sliceIndices, order, &frameSlices[orientationIndex]);
+
+        // Half a turn later the projections are the same, negated.
+        for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+            projections[panelIndex] = -projections[panelIndex];
+        }
+
+        sweepProjections(geometry, projections, getFrameSliceWidth(geometry, oppositeAngle), sliceIndices, order, &frameSlices[oppositeOrientationIndex]);
+    }
+
+    delete [] projections;
+    delete [] sliceIndices;
+    delete [] order;
+}
+
+bool isPointInsideGeometryPanel(const LayoutGeometry* geometry, int panelIndex, coord_t x, coord_t y) {
+    int firstVertexIndex = geometry->vertexOffsets[panelIndex];
+    int lastVertexIndex = geometry->vertexOffsets[panelIndex + 1] - 1;
+
+    int expectedSign = 0;
+
+    for (int vertexIndex = firstVertexIndex; vertexIndex <= lastVertexIndex; vertexIndex++) {
+        int nextVertexIndex = vertexIndex == lastVertexIndex ? firstVertexIndex : vertexIndex + 1;
+
+        Vec2 edge = geometry->vertices.get(nextVertexIndex) - geometry->vertices.get(vertexIndex);
+        Vec2 offset = Vec2(x, y) - geometry->vertices.get(vertexIndex);
+
+        int sign = coordCrossSign(edge.x, offset.y, edge.y, offset.x);
+
+        if (sign == 0) {
+            continue;
+        }
+
+        if (expectedSign == 0) {
+            expectedSign = sign;
+        } else if (sign != expectedSign) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int pointInsideWhichGeometryPanel(const LayoutGeometry* geometry, coord_t x, coord_t y) {
+    for (int panelIndex = 0; panelIndex < geometry->nPanels; panelIndex++) {
+        if (isPointInsideGeometryPanel(geometry, panelIndex, x, y)) {
+            return geometry->panelIds[panelIndex];
+        }
+    }
+
+    return -1;
+}
+
+void findGeometryPanelIndices(const LayoutGeometry* geometry, const int* panelIds, int nPanelIds, int* panelIndices) {
+    int nPanels = geometry->nPanels;
+    int* sortedPanelIndices = new int[nPanels];
+
+    for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+        sortedPanelIndices[panelIndex] = panelIndex;
+    }
+
+    const int* geometryPanelIds = geometry->panelIds;
+
+    std::sort(sortedPanelIndices, sortedPanelIndices + nPanels, [geometryPanelIds](int firstPanelIndex, int secondPanelIndex) -> bool {
+        return geometryPanelIds[firstPanelIndex] < geometryPanelIds[secondPanelIndex];
+    });
+
+    for (int panelIdIndex = 0; panelIdIndex < nPanelIds; panelIdIndex++) {
+        int panelId = panelIds[panelIdIndex];
+        const int* found = std::lower_bound(sortedPanelIndices, sortedPanelIndices + nPanels, panelId, [geometryPanelIds](int panelIndex, int value) -> bool {
+            return geometryPanelIds[panelIndex] < value;
+        });
+
+        panelIndices[panelIdIndex] = found != sortedPanelIndices + nPanels && geometryPanelIds[*found] == panelId ? *found : -1;
+    }
+
+    delete [] sortedPanelIndices;
+}
+
+void freeLayoutGeometry(LayoutGeometry* geometry) {
+    if (geometry->mapping) {
+        munmap(geometry->mapping, geometry->mappingSize);
+    } else if (geometry->arena) {
+        delete [] geometry->arena;
+    }
+
+    geometry->arena = NULL;
+    geometry->mapping = NULL;
+    geometry->mappingSize = 0;
+    geometry->nPanels = 0;
+    geometry->panelIds = NULL;
+    geometry->shapeTypes = NULL;
+    geometry->orientations = NULL;
+    geometry->centroids = PointArray();
+    geometry->vertexOffsets = NULL;
+    geometry->vertices = PointArray();
+    geometry->totalRotation = 0;
+}
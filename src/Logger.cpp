@@ -0,0 +1,105 @@
+/*
+ * Logger.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <atomic>
+
+#include "Logger.h"
+#include "MonotonicClock.h"
+
+/* Data */
+
+static LogRecord logRing[LOG_RING_CAPACITY];
+
+static std::atomic<uint64_t> logWriteIndex(0);
+static uint64_t logReadIndex = 0;
+
+static std::atomic<int> logLevel(LOG_LEVEL_WARNING);
+
+/* Helpers */
+
+static const char* levelName(int level) {
+    switch (level) {
+        case LOG_LEVEL_ERROR:
+            return "E";
+        case LOG_LEVEL_WARNING:
+            return "W";
+        case LOG_LEVEL_INFO:
+            return "I";
+        default:
+            return "D";
+    }
+}
+
+/* API */
+
+void setLogLevel(int level) {
+    logLevel.store(level, std::memory_order_relaxed);
+}
+
+int getLogLevel() {
+    return logLevel.load(std::memory_order_relaxed);
+}
+
+void appendLogRecord(int level, const char* format, const int32_t* arguments, int nArguments) {
+    // Claiming a slot is the only shared write, so concurrent writers never wait on each other.
+    uint64_t index = logWriteIndex.fetch_add(1, std::memory_order_relaxed);
+    LogRecord& record = logRing[index & (LOG_RING_CAPACITY - 1)];
+
+    __atomic_store_n(&record.sequence, 0, __ATOMIC_RELAXED);
+
+    // Readers must see the cleared sequence before any of the fields below start changing.
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    record.timestamp = monotonicNanoseconds() / 1000;
+    record.format = format;
+    record.level = level;
+    record.nArguments = nArguments;
+
+    for (int argumentIndex = 0; argumentIndex < LOG_RECORD_ARGUMENTS_COUNT; argumentIndex++) {
+        record.arguments[argumentIndex] = argumentIndex < nArguments ? arguments[argumentIndex] : 0;
+    }
+
+    __atomic_store_n(&record.sequence, index + 1, __ATOMIC_RELEASE);
+}
+
+int dumpLogRecords(FILE* stream) {
+    uint64_t writeIndex = logWriteIndex.load(std::memory_order_acquire);
+
+    // Whatever is older than the ring capacity has been overwritten already.
+    if (writeIndex - logReadIndex > LOG_RING_CAPACITY) {
+        fprintf(stream, "[log] %llu records lost\n", (unsigned long long)(writeIndex - LOG_RING_CAPACITY - logReadIndex));
+
+        logReadIndex = writeIndex - LOG_RING_CAPACITY;
+    }
+
+    int dumpedCount = 0;
+
+    for (; logReadIndex < writeIndex; logReadIndex++) {
+        const LogRecord& slot = logRing[logReadIndex & (LOG_RING_CAPACITY - 1)];
+
+        // Skip slots that are still being written, or were already reused by a newer record.
+        if (__atomic_load_n(&slot.sequence, __ATOMIC_ACQUIRE) != logReadIndex + 1) {
+            continue;
+        }
+
+        // Format a copy, and only if no writer lapped the reader while it was taken, else it may be torn.
+        LogRecord record = slot;
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&slot.sequence, __ATOMIC_RELAXED) != logReadIndex + 1) {
+            continue;
+        }
+
+        fprintf(stream, "[%llu.%06llu] %s ", (unsigned long long)(record.timestamp / 1000000), (unsigned long long)(record.timestamp % 1000000), levelName(record.level));
+        fprintf(stream, record.format, record.arguments[0], record.arguments[1], record.arguments[2], record.arguments[3]);
+        fprintf(stream, "\n");
+
+        dumpedCount++;
+    }
+
+    return dumpedCount;
+}
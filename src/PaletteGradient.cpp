@@ -0,0 +1,109 @@
+/*
+ * PaletteGradient.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "PaletteGradient.h"
+
+/* Constants */
+
+static const int HUE_CIRCLE = 360;
+
+/* Helpers */
+
+/**
+ * Internal helper: whether the entries were built from this palette, in this space
+ */
+static bool isBuiltFrom(const PaletteGradient* gradient, const RGB_t* colors, int nColors, int space) {
+    if (!gradient->built || gradient->space != space || (int)gradient->paletteColors.size() != nColors) {
+        return false;
+    }
+
+    for (int colorIndex = 0; colorIndex < nColors; colorIndex++) {
+        const RGB_t& builtColor = gradient->paletteColors[colorIndex];
+
+        if (builtColor.R != colors[colorIndex].R || builtColor.G != colors[colorIndex].G || builtColor.B != colors[colorIndex].B) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static uint8_t clampGradientByte(int value) {
+    return value < 0 ? 0 : value > 255 ? 255 : value;
+}
+
+/**
+ * Internal helper: interpolate with a weight out of the span, rounding to the closest
+ */
+static int interpolate(int lower, int upper, int weight, int span) {
+    int difference = (upper - lower) * weight;
+
+    return lower + (difference >= 0 ? difference + span / 2 : difference - span / 2) / span;
+}
+
+/* API */
+
+bool updatePaletteGradient(PaletteGradient* gradient, const RGB_t* colors, int nColors, int space) {
+    if (isBuiltFrom(gradient, colors, nColors, space)) {
+        return false;
+    }
+
+    for (int entryIndex = 0; entryIndex < PALETTE_GRADIENT_SIZE; entryIndex++) {
+        RGB_t color = {0, 0, 0};
+
+        if (nColors == 1) {
+            color = colors[0];
+        } else if (nColors > 1) {
+            // Where the entry falls between two palette colors, as a fraction of span.
+            int span = PALETTE_GRADIENT_SIZE - 1;
+            int scaledPosition = entryIndex * (nColors - 1);
+            int lowerColorIndex = scaledPosition / span;
+            int weight = scaledPosition % span;
+            int upperColorIndex = lowerColorIndex + 1 < nColors ? lowerColorIndex + 1 : lowerColorIndex;
+
+            const RGB_t& lowerColor = colors[lowerColorIndex];
+            const RGB_t& upperColor = colors[upperColorIndex];
+
+            if (space == GRADIENT_HSV) {
+                HSV_t lower;
+                HSV_t upper;
+
+                RGBtoHSV(lowerColor, &lower);
+                RGBtoHSV(upperColor, &upper);
+
+                // Go around the hue circle by the shortest way.
+                int hueDifference = upper.H - lower.H;
+
+                if (hueDifference > HUE_CIRCLE / 2) {
+                    hueDifference -= HUE_CIRCLE;
+                } else if (hueDifference < -HUE_CIRCLE / 2) {
+                    hueDifference += HUE_CIRCLE;
+                }
+
+                HSV_t hsv;
+                hsv.H = (interpolate(lower.H, lower.H + hueDifference, weight, span) % HUE_CIRCLE + HUE_CIRCLE) % HUE_CIRCLE;
+                hsv.S = interpolate(lower.S, upper.S, weight, span);
+                hsv.V = interpolate(lower.V, upper.V, weight, span);
+
+                HSVtoRGB(hsv, &color);
+            } else {
+                color.R = interpolate(lowerColor.R, upperColor.R, weight, span);
+                color.G = interpolate(lowerColor.G, upperColor.G, weight, span);
+                color.B = interpolate(lowerColor.B, upperColor.B, weight, span);
+            }
+        }
+
+        gradient->entries[entryIndex * 3] = clampGradientByte(color.R);
+        gradient->entries[entryIndex * 3 + 1] = clampGradientByte(color.G);
+        gradient->entries[entryIndex * 3 + 2] = clampGradientByte(color.B);
+    }
+
+    gradient->paletteColors.assign(colors, colors + nColors);
+    gradient->space = space;
+    gradient->built = true;
+
+    return true;
+}
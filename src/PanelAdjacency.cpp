@@ -0,0 +1,181 @@
+/*
+ * PanelAdjacency.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <stdint.h>
+
+#include "PanelAdjacency.h"
+
+/* Constants */
+
+static const double EDGE_CELL_SIZE = 0.25;			// in side lengths, well under the distance between two edges of a panel
+static const double EDGE_MATCH_TOLERANCE = 0.05;	// in side lengths
+
+static const int EMPTY_EDGE_SLOT = -1;
+
+/* Helpers */
+
+/**
+ * One unmatched edge waiting in the hash table for the panel on its other side
+ */
+struct EdgeSlot {
+	int cellX;
+	int cellY;
+	int panelIndex;
+	coord_t midpointX;
+	coord_t midpointY;
+};
+
+static uint32_t hashEdgeCell(int cellX, int cellY) {
+    return ((uint32_t)cellX * 0x9E3779B1u) ^ ((uint32_t)cellY * 0x85EBCA77u);
+}
+
+static coord_t absoluteCoord(coord_t value) {
+    return value < 0 ? -value : value;
+}
+
+/**
+ * Internal helper: look for an unmatched edge of another panel with the same midpoint, in the cell of the midpoint
+ * and the 8 around it, since noise can push the two copies of a midpoint across a cell boundary
+ * @return: the slot of the matching edge, EMPTY_EDGE_SLOT if none
+ */
+static int findEdgeSlot(const EdgeSlot* slots, uint32_t mask, int cellX, int cellY, int panelIndex, coord_t midpointX, coord_t midpointY, coord_t tolerance) {
+    for (int offsetY = -1; offsetY <= 1; offsetY++) {
+        for (int offsetX = -1; offsetX <= 1; offsetX++) {
+            int probeX = cellX + offsetX;
+            int probeY = cellY + offsetY;
+
+            for (uint32_t slotIndex = hashEdgeCell(probeX, probeY) & mask; slots[slotIndex].panelIndex != EMPTY_EDGE_SLOT; slotIndex = (slotIndex + 1) & mask) {
+                const EdgeSlot& slot = slots[slotIndex];
+
+                if (slot.cellX == probeX && slot.cellY == probeY && slot.panelIndex != panelIndex
+                        && absoluteCoord(slot.midpointX - midpointX) <= tolerance && absoluteCoord(slot.midpointY - midpointY) <= tolerance) {
+                    return slotIndex;
+                }
+            }
+        }
+    }
+
+    return EMPTY_EDGE_SLOT;
+}
+
+/* API */
+
+void buildPanelAdjacency(const LayoutGeometry* geometry, PanelAdjacency* adjacency) {
+    freePanelAdjacency(adjacency);
+
+    int nPanels = geometry->nPanels;
+    int nVertices = nPanels > 0 ? geometry->vertexOffsets[nPanels] : 0;
+
+    // Open addressing with a load factor of at most a half, every slot stays put once written.
+    uint32_t slotsCount = 1;
+
+    while (slotsCount < 2 * (uint32_t)nVertices + 1) {
+        slotsCount <<= 1;
+    }
+
+    uint32_t mask = slotsCount - 1;
+    EdgeSlot* slots = new EdgeSlot[slotsCount];
+
+    for (uint32_t slotIndex = 0; slotIndex < slotsCount; slotIndex++) {
+        slots[slotIndex].panelIndex = EMPTY_EDGE_SLOT;
+    }
+
+    // Each edge is shared at most once, so there are at most nVertices / 2 pairs.
+    int* pairs = new int[nVertices + 1];
+    int nPairs = 0;
+
+    Vec2 minimum;
+    Vec2 maximum;
+
+    boundsOfPointArray(geometry->vertices, &minimum, &maximum);
+
+    coord_t cellSize = COORD_FROM_SIDE_LENGTHS(EDGE_CELL_SIZE);
+    coord_t tolerance = COORD_FROM_SIDE_LENGTHS(EDGE_MATCH_TOLERANCE);
+
+    for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+        if (geometry->shapeTypes[panelIndex] == SHAPE_RHYTHM) {
+            continue;
+        }
+
+        int firstVertexIndex = geometry->vertexOffsets[panelIndex];
+        int lastVertexIndex = geometry->vertexOffsets[panelIndex + 1] - 1;
+
+        for (int vertexIndex = firstVertexIndex; vertexIndex <= lastVertexIndex; vertexIndex++) {
+            int nextVertexIndex = vertexIndex == lastVertexIndex ? firstVertexIndex : vertexIndex + 1;
+
+            // Offset from the minimum first, so that the sum stays in range and the cells are non-negative.
+            coord_t midpointX = (geometry->vertices.x[vertexIndex] - minimum.x) / 2 + (geometry->vertices.x[nextVertexIndex] - minimum.x) / 2;
+            coord_t midpointY = (geometry->vertices.y[vertexIndex] - minimum.y) / 2 + (geometry->vertices.y[nextVertexIndex] - minimum.y) / 2;
+
+            int cellX = coordDivideRounded(midpointX, cellSize);
+            int cellY = coordDivideRounded(midpointY, cellSize);
+
+            int matchingSlotIndex = findEdgeSlot(slots, mask, cellX, cellY, panelIndex, midpointX, midpointY, tolerance);
+
+            if (matchingSlotIndex != EMPTY_EDGE_SLOT) {
+                pairs[nPairs++] = slots[matchingSlotIndex].panelIndex;
+                pairs[nPairs++] = panelIndex;
+
+                // Keep the slot so that probe chains stay intact, but make sure it never matches again.
+                slots[matchingSlotIndex].cellX = INT32_MIN;
+
+                continue;
+            }
+
+            uint32_t slotIndex = hashEdgeCell(cellX, cellY) & mask;
+
+            while (slots[slotIndex].panelIndex != EMPTY_EDGE_SLOT) {
+                slotIndex = (slotIndex + 1) & mask;
+            }
+
+            slots[slotIndex] = {cellX, cellY, panelIndex, midpointX, midpointY};
+        }
+    }
+
+    delete [] slots;
+
+    // Counting sort of both directions of every pair into the rows.
+    adjacency->nPanels = nPanels;
+    adjacency->nNeighbours = nPairs;
+    adjacency->offsets = new int[nPanels + 1 + nPairs];
+    adjacency->neighbours = adjacency->offsets + nPanels + 1;
+
+    int* offsets = adjacency->offsets;
+
+    for (int panelIndex = 0; panelIndex <= nPanels; panelIndex++) {
+        offsets[panelIndex] = 0;
+    }
+
+    for (int pairIndex = 0; pairIndex < nPairs; pairIndex++) {
+        offsets[pairs[pairIndex] + 1]++;
+    }
+
+    for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+        offsets[panelIndex + 1] += offsets[panelIndex];
+    }
+
+    for (int pairIndex = 0; pairIndex < nPairs; pairIndex += 2) {
+        adjacency->neighbours[offsets[pairs[pairIndex]]++] = pairs[pairIndex + 1];
+        adjacency->neighbours[offsets[pairs[pairIndex + 1]]++] = pairs[pairIndex];
+    }
+
+    for (int panelIndex = nPanels; panelIndex > 0; panelIndex--) {
+        offsets[panelIndex] = offsets[panelIndex - 1];
+    }
+
+    offsets[0] = 0;
+
+    delete [] pairs;
+}
+
+void freePanelAdjacency(PanelAdjacency* adjacency) {
+    delete [] adjacency->offsets;
+
+    adjacency->nPanels = 0;
+    adjacency->nNeighbours = 0;
+    adjacency->offsets = NULL;
+    adjacency->neighbours = NULL;
+}
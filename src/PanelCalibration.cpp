@@ -0,0 +1,164 @@
+/*
+ * PanelCalibration.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "PanelCalibration.h"
+#include "FrameCompositor.h"
+
+/* Constants */
+
+static const int FULL_GAIN_PERCENT = 100;
+static const int MAXIMUM_GAIN_PERCENT = 400;
+static const int MAXIMUM_OFFSET = 255;
+static const int CALIBRATION_LINE_LENGTH = 256;
+
+/* Helpers */
+
+/**
+ * Internal helper: one line of the calibration file
+ */
+struct CalibrationEntry {
+    int panelId;
+    uint16_t gains[FRAME_CHANNELS_COUNT];
+    int16_t offsets[FRAME_CHANNELS_COUNT];
+
+    bool operator<(const CalibrationEntry& other) const {
+        return panelId < other.panelId;
+    }
+};
+
+/**
+ * Internal helper: read every entry of the file into a growing array, sorted by panelId
+ * @return: the number of entries, -1 if the file cannot be read
+ */
+static int readCalibrationEntries(const char* path, CalibrationEntry** entries) {
+    *entries = NULL;
+
+    FILE* file = fopen(path, "r");
+
+    if (file == NULL) {
+        return -1;
+    }
+
+    char line[CALIBRATION_LINE_LENGTH];
+    int nEntries = 0;
+    int capacity = 0;
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        int panelId;
+        int gains[FRAME_CHANNELS_COUNT];
+        int offsets[FRAME_CHANNELS_COUNT];
+
+        if (line[0] == '#' || sscanf(line, "%d %d %d %d %d %d %d", &panelId, &gains[0], &gains[1], &gains[2],
+                                     &offsets[0], &offsets[1], &offsets[2]) != 7) {
+            continue;
+        }
+
+        if (nEntries == capacity) {
+            capacity = capacity > 0 ? capacity * 2 : 64;
+            *entries = (CalibrationEntry*)realloc(*entries, capacity * sizeof(CalibrationEntry));
+        }
+
+        CalibrationEntry& entry = (*entries)[nEntries++];
+        entry.panelId = panelId;
+
+        for (int channel = 0; channel < FRAME_CHANNELS_COUNT; channel++) {
+            int gain = std::max(0, std::min(MAXIMUM_GAIN_PERCENT, gains[channel]));
+            entry.gains[channel] = (gain * PANEL_CALIBRATION_UNIT_GAIN + FULL_GAIN_PERCENT / 2) / FULL_GAIN_PERCENT;
+            entry.offsets[channel] = std::max(-MAXIMUM_OFFSET, std::min(MAXIMUM_OFFSET, offsets[channel]));
+        }
+    }
+
+    fclose(file);
+
+    // The last line for a panel wins, as if the file were applied top to bottom.
+    std::stable_sort(*entries, *entries + nEntries);
+
+    return nEntries;
+}
+
+/* API */
+
+int loadPanelCalibration(PanelCalibration* calibration, const char* path, const int* panelIds, int nPanels) {
+    freePanelCalibration(calibration);
+
+    calibration->nPanels = nPanels;
+    calibration->gains = (uint16_t*)malloc(nPanels * FRAME_CHANNELS_COUNT * sizeof(uint16_t));
+    calibration->offsets = (int16_t*)malloc(nPanels * FRAME_CHANNELS_COUNT * sizeof(int16_t));
+
+    for (int index = 0; index < nPanels * FRAME_CHANNELS_COUNT; index++) {
+        calibration->gains[index] = PANEL_CALIBRATION_UNIT_GAIN;
+        calibration->offsets[index] = 0;
+    }
+
+    CalibrationEntry* entries;
+    int nEntries = readCalibrationEntries(path, &entries);
+
+    if (nEntries < 0) {
+        return -1;
+    }
+
+    int nCalibrated = 0;
+    bool identity = true;
+
+    for (int frameIndex = 0; frameIndex < nPanels; frameIndex++) {
+        CalibrationEntry key;
+        key.panelId = panelIds[frameIndex];
+
+        // Last of the equal range, the entry read last.
+        CalibrationEntry* entry = std::upper_bound(entries, entries + nEntries, key);
+
+        if (entry == entries || (entry - 1)->panelId != key.panelId) {
+            continue;
+        }
+
+        entry--;
+        nCalibrated++;
+
+        for (int channel = 0; channel < FRAME_CHANNELS_COUNT; channel++) {
+            int index = frameIndex * FRAME_CHANNELS_COUNT + channel;
+
+            calibration->gains[index] = entry->gains[channel];
+            calibration->offsets[index] = entry->offsets[channel];
+            identity = identity && entry->gains[channel] == PANEL_CALIBRATION_UNIT_GAIN && entry->offsets[channel] == 0;
+        }
+    }
+
+    free(entries);
+    calibration->identity = identity;
+
+    return nCalibrated;
+}
+
+void applyPanelCalibration(const PanelCalibration* calibration, uint8_t* channels, int nPanels) {
+    if (calibration->identity) {
+        return;
+    }
+
+    const uint16_t* __restrict__ gains = calibration->gains;
+    const int16_t* __restrict__ offsets = calibration->offsets;
+    uint8_t* __restrict__ output = channels;
+
+    for (int index = 0; index < nPanels * FRAME_CHANNELS_COUNT; index++) {
+        int level = ((output[index] * gains[index] + PANEL_CALIBRATION_UNIT_GAIN / 2) >> PANEL_CALIBRATION_GAIN_BITS) + offsets[index];
+
+        level = level < 0 ? 0 : level > 255 ? 255 : level;
+        output[index] = output[index] == 0 ? 0 : level;
+    }
+}
+
+void freePanelCalibration(PanelCalibration* calibration) {
+    free(calibration->gains);
+    free(calibration->offsets);
+    calibration->gains = NULL;
+    calibration->offsets = NULL;
+    calibration->nPanels = 0;
+    calibration->identity = true;
+}
@@ -0,0 +1,130 @@
+/*
+ * PanelDistanceField.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "PanelDistanceField.h"
+
+/* Helpers */
+
+static uint8_t clampGlowByte(int value) {
+    return value < 0 ? 0 : value > 255 ? 255 : value;
+}
+
+/* API */
+
+void buildPanelDistanceField(const LayoutGeometry* geometry, const PanelAdjacency* adjacency, int sourcePanelIndex, const int* panelIndices, int nPanels, PanelDistanceField* field) {
+    freePanelDistanceField(field);
+
+    field->nPanels = nPanels;
+    field->graphDistances = new uint8_t[nPanels];
+    field->euclideanDistances = new uint16_t[nPanels];
+
+    int nGeometryPanels = geometry->nPanels;
+
+    uint8_t* hops = new uint8_t[nGeometryPanels];
+    int* queue = new int[nGeometryPanels];
+    coord_t* distances = new coord_t[nGeometryPanels];
+
+    for (int panelIndex = 0; panelIndex < nGeometryPanels; panelIndex++) {
+        hops[panelIndex] = UNREACHABLE_GRAPH_DISTANCE;
+    }
+
+    // Breadth first search, every panel enters the queue once.
+    int queueHead = 0;
+    int queueTail = 0;
+
+    hops[sourcePanelIndex] = 0;
+    queue[queueTail++] = sourcePanelIndex;
+
+    while (queueHead < queueTail) {
+        int panelIndex = queue[queueHead++];
+        int nextHops = hops[panelIndex] + 1;
+
+        if (nextHops >= UNREACHABLE_GRAPH_DISTANCE) {
+            break;
+        }
+
+        const int* neighbours = adjacency->getNeighbours(panelIndex);
+
+        for (int neighbourIndex = 0; neighbourIndex < adjacency->getNeighboursCount(panelIndex); neighbourIndex++) {
+            int neighbour = neighbours[neighbourIndex];
+
+            if (hops[neighbour] == UNREACHABLE_GRAPH_DISTANCE) {
+                hops[neighbour] = nextHops;
+                queue[queueTail++] = neighbour;
+            }
+        }
+    }
+
+    distancesToPoint(geometry->centroids, geometry->centroids.get(sourcePanelIndex), distances);
+
+    coord_t unit = COORD_FROM_SIDE_LENGTHS(1.0 / EUCLIDEAN_DISTANCE_UNITS_PER_SIDE);
+
+    for (int frameIndex = 0; frameIndex < nPanels; frameIndex++) {
+        int panelIndex = panelIndices[frameIndex];
+        int distance = coordDivideRounded(distances[panelIndex], unit);
+
+        field->graphDistances[frameIndex] = hops[panelIndex];
+        field->euclideanDistances[frameIndex] = distance > MAXIMUM_EUCLIDEAN_DISTANCE ? MAXIMUM_EUCLIDEAN_DISTANCE : distance;
+    }
+
+    delete [] hops;
+    delete [] queue;
+    delete [] distances;
+}
+
+void buildGlowFalloff(uint8_t* levels, int radius) {
+    for (int distance = 0; distance < GLOW_FALLOFF_LEVELS_COUNT; distance++) {
+        if (distance >= radius) {
+            levels[distance] = 0;
+            continue;
+        }
+
+        double remaining = 1.0 - (double)distance / radius;
+
+        levels[distance] = clampGlowByte((int)(remaining * remaining * 255 + 0.5));
+    }
+}
+
+void glowFrameLayer(FrameLayer* layer, const PanelDistanceField* field, int metric, const uint8_t* levels, const RGB_t& color) {
+    uint8_t* __restrict__ channels = layer->channels;
+    uint8_t* __restrict__ alphas = layer->alphas;
+
+    uint8_t red = clampGlowByte(color.R);
+    uint8_t green = clampGlowByte(color.G);
+    uint8_t blue = clampGlowByte(color.B);
+
+    for (int frameIndex = 0; frameIndex < field->nPanels; frameIndex++) {
+        channels[frameIndex * FRAME_CHANNELS_COUNT] = red;
+        channels[frameIndex * FRAME_CHANNELS_COUNT + 1] = green;
+        channels[frameIndex * FRAME_CHANNELS_COUNT + 2] = blue;
+    }
+
+    if (metric == DISTANCE_GRAPH) {
+        const uint8_t* __restrict__ distances = field->graphDistances;
+
+        // UNREACHABLE_GRAPH_DISTANCE is the last entry of the table, any radius within the table leaves it dark.
+        for (int frameIndex = 0; frameIndex < field->nPanels; frameIndex++) {
+            alphas[frameIndex] = levels[distances[frameIndex]];
+        }
+    } else {
+        const uint16_t* __restrict__ distances = field->euclideanDistances;
+
+        for (int frameIndex = 0; frameIndex < field->nPanels; frameIndex++) {
+            uint16_t distance = distances[frameIndex];
+
+            alphas[frameIndex] = distance < GLOW_FALLOFF_LEVELS_COUNT ? levels[distance] : 0;
+        }
+    }
+}
+
+void freePanelDistanceField(PanelDistanceField* field) {
+    delete [] field->graphDistances;
+    delete [] field->euclideanDistances;
+
+    field->nPanels = 0;
+    field->graphDistances = NULL;
+    field->euclideanDistances = NULL;
+}
@@ -0,0 +1,115 @@
+/*
+ * PanelOrdering.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <algorithm>
+
+#include "PanelOrdering.h"
+
+/* Constants */
+
+static const uint32_t CURVE_SIZE = 1u << PANEL_CURVE_BITS;
+
+/* Helpers */
+
+/**
+ * Internal helper: move the 16 low bits of value to the even bits
+ */
+static uint32_t spreadBits(uint32_t value) {
+    value &= 0x0000FFFF;
+    value = (value | (value << 8)) & 0x00FF00FF;
+    value = (value | (value << 4)) & 0x0F0F0F0F;
+    value = (value | (value << 2)) & 0x33333333;
+    value = (value | (value << 1)) & 0x55555555;
+
+    return value;
+}
+
+/**
+ * Internal helper: quantize a coordinate into [0, CURVE_SIZE) given the extent of the layout
+ */
+static uint32_t quantizeCoord(coord_t value, coord_t minimum, coord_t cellSize) {
+    int cell = coordDivideRounded(value - minimum, cellSize);
+
+    return cell >= (int)CURVE_SIZE ? CURVE_SIZE - 1 : cell;
+}
+
+/* API */
+
+uint32_t getMortonIndex(uint32_t x, uint32_t y) {
+    return spreadBits(x) | (spreadBits(y) << 1);
+}
+
+uint32_t getHilbertIndex(uint32_t x, uint32_t y) {
+    uint32_t index = 0;
+
+    for (uint32_t size = CURVE_SIZE / 2; size > 0; size /= 2) {
+        uint32_t rx = (x & size) != 0;
+        uint32_t ry = (y & size) != 0;
+
+        index += size * size * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant so that the curve inside it starts and ends at the right corners.
+        if (ry == 0) {
+            if (rx == 1) {
+                x = CURVE_SIZE - 1 - x;
+                y = CURVE_SIZE - 1 - y;
+            }
+
+            std::swap(x, y);
+        }
+    }
+
+    return index;
+}
+
+void orderPanelsAlongCurve(const LayoutGeometry* geometry, const int* panelIndices, int nPanels, int order, int* permutation) {
+    for (int position = 0; position < nPanels; position++) {
+        permutation[position] = position;
+    }
+
+    if (order == PANEL_ORDER_SLICES || nPanels == 0) {
+        return;
+    }
+
+    Vec2 minimum = geometry->centroids.get(panelIndices[0]);
+    Vec2 maximum = minimum;
+
+    for (int position = 1; position < nPanels; position++) {
+        Vec2 centroid = geometry->centroids.get(panelIndices[position]);
+
+        minimum.x = std::min(minimum.x, centroid.x);
+        minimum.y = std::min(minimum.y, centroid.y);
+        maximum.x = std::max(maximum.x, centroid.x);
+        maximum.y = std::max(maximum.y, centroid.y);
+    }
+
+    // The same cell size on both axes keeps the curve from being stretched.
+    coord_t extent = std::max(maximum.x - minimum.x, maximum.y - minimum.y);
+    coord_t cellSize = extent / (coord_t)(CURVE_SIZE - 1);
+
+    if (cellSize <= 0) {
+        cellSize = COORD_FROM_SIDE_LENGTHS(1.0);
+    }
+
+    uint32_t* codes = new uint32_t[nPanels];
+
+    for (int position = 0; position < nPanels; position++) {
+        Vec2 centroid = geometry->centroids.get(panelIndices[position]);
+        uint32_t x = quantizeCoord(centroid.x, minimum.x, cellSize);
+        uint32_t y = quantizeCoord(centroid.y, minimum.y, cellSize);
+
+        codes[position] = order == PANEL_ORDER_HILBERT ? getHilbertIndex(x, y) : getMortonIndex(x, y);
+    }
+
+    std::sort(permutation, permutation + nPanels, [codes](int firstPosition, int secondPosition) -> bool {
+        if (codes[firstPosition] != codes[secondPosition]) {
+            return codes[firstPosition] < codes[secondPosition];
+        }
+        return firstPosition < secondPosition;
+    });
+
+    delete [] codes;
+}
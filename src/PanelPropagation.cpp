@@ -0,0 +1,323 @@
+/*
+ * PanelPropagation.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <string.h>
+
+#include "PanelPropagation.h"
+
+/* Constants */
+
+// The ripple divides twice the sum of the neighbours by the degree with 12 fraction bits, rounding towards zero so that waves die out:
+// sums stay under 2^14 and reciprocals under 2^14, so the products fit in 32 bits.
+static const int RIPPLE_RECIPROCAL_BITS = 12;
+static const int DIFFUSION_RECIPROCAL_BITS = 16;
+
+// Heights that render darker than 1 out of 255.
+static const int RIPPLE_QUIET_HEIGHT = PROPAGATION_MAXIMUM_HEIGHT / 255 + 1;
+
+/* Helpers */
+
+/**
+ * Internal helper: clamp a height, and flatten the ones too low to show so that a wave really ends
+ */
+static int16_t settleHeight(int height) {
+    if (height < RIPPLE_QUIET_HEIGHT && height > -RIPPLE_QUIET_HEIGHT) {
+        return 0;
+    }
+    return height > PROPAGATION_MAXIMUM_HEIGHT ? PROPAGATION_MAXIMUM_HEIGHT : height < -PROPAGATION_MAXIMUM_HEIGHT ? -PROPAGATION_MAXIMUM_HEIGHT : height;
+}
+
+/**
+ * Internal helper: the classic two-buffer ripple, next = 2 * mean(neighbours) - previous, damped.
+ * The next heights are written over the previous ones, which are read first
+ */
+template <int ROW_WIDTH>
+static bool stepRippleRows(const int* __restrict__ rows, const int32_t* __restrict__ reciprocals, const int16_t* __restrict__ current, int16_t* __restrict__ next, int nPanels, int retention) {
+    int lit = 0;
+
+    for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+        const int* row = rows + panelIndex * ROW_WIDTH;
+        int sum = 0;
+
+        for (int column = 0; column < ROW_WIDTH; column++) {
+            sum += current[row[column]];
+        }
+
+        int height = (sum * reciprocals[panelIndex]) / (1 << RIPPLE_RECIPROCAL_BITS) - next[panelIndex];
+
+        next[panelIndex] = settleHeight((height * retention) / PROPAGATION_FULL_RETENTION);
+        lit |= next[panelIndex];
+    }
+
+    return lit != 0;
+}
+
+static bool stepRippleIrregular(const int* offsets, const int* neighbours, const int32_t* reciprocals, const int16_t* current, int16_t* next, int nPanels, int retention) {
+    int lit = 0;
+
+    for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+        int sum = 0;
+
+        for (int neighbourIndex = offsets[panelIndex]; neighbourIndex < offsets[panelIndex + 1]; neighbourIndex++) {
+            sum += current[neighbours[neighbourIndex]];
+        }
+
+        int height = (sum * reciprocals[panelIndex]) / (1 << RIPPLE_RECIPROCAL_BITS) - next[panelIndex];
+
+        next[panelIndex] = settleHeight((height * retention) / PROPAGATION_FULL_RETENTION);
+        lit |= next[panelIndex];
+    }
+
+    return lit != 0;
+}
+
+/**
+ * Internal helper: every channel becomes the mean of itself and its neighbours, damped
+ */
+template <int ROW_WIDTH>
+static bool stepDiffusionRows(const int* __restrict__ rows, const int32_t* __restrict__ reciprocals, const uint8_t* __restrict__ current, uint8_t* __restrict__ next, int nPanels, int retention) {
+    int lit = 0;
+
+    for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+        const int* row = rows + panelIndex * ROW_WIDTH;
+
+        for (int channel = 0; channel < FRAME_CHANNELS_COUNT; channel++) {
+            uint32_t sum = current[panelIndex * FRAME_CHANNELS_COUNT + channel];
+
+            for (int column = 0; column < ROW_WIDTH; column++) {
+                sum += current[row[column] * FRAME_CHANNELS_COUNT + channel];
+            }
+
+            uint32_t mean = (sum * reciprocals[panelIndex]) >> DIFFUSION_RECIPROCAL_BITS;
+
+            next[panelIndex * FRAME_CHANNELS_COUNT + channel] = (mean * retention) / PROPAGATION_FULL_RETENTION;
+            lit |= next[panelIndex * FRAME_CHANNELS_COUNT + channel];
+        }
+    }
+
+    return lit != 0;
+}
+
+static bool stepDiffusionIrregular(const int* offsets, const int* neighbours, const int32_t* reciprocals, const uint8_t* current, uint8_t* next, int nPanels, int retention) {
+    int lit = 0;
+
+    for (int panelIndex = 0; panelIndex < nPanels; panelIndex++) {
+        for (int channel = 0; channel < FRAME_CHANNELS_COUNT; channel++) {
+            uint32_t sum = current[panelIndex * FRAME_CHANNELS_COUNT + channel];
+
+            for (int neighbourIndex = offsets[panelIndex]; neighbourIndex < offsets[panelIndex + 1]; neighbourIndex++) {
+                sum += current[neighbours[neighbourIndex] * FRAME_CHANNELS_COUNT + channel];
+            }
+
+            uint32_t mean = (sum * reciprocals[panelIndex]) >> DIFFUSION_RECIPROCAL_BITS;
+
+            next[panelIndex * FRAME_CHANNELS_COUNT + channel] = (mean * retention) / PROPAGATION_FULL_RETENTION;
+            lit |= next[panelIndex * FRAME_CHANNELS_COUNT + channel];
+        }
+    }
+
+    return lit != 0;
+}
+
+static uint8_t clampPropagationByte(int value) {
+    return value < 0 ? 0 : value > 255 ? 255 : value;
+}
+
+/* API */
+
+void initPanelPropagation(const PanelAdjacency* adjacency, const int* panelIndices, int nPanels, int rule, int retention, PanelPropagation* propagation) {
+    freePanelPropagation(propagation);
+
+    propagation->nPanels = nPanels;
+    propagation->rule = rule;
+    propagation->retention = retention;
+
+    // Map the geometry indices of the graph to frame indices, panels outside the frame are left out.
+    int* frameIndices = new int[adjacency->nPanels];
+
+    for (int panelIndex = 0; panelIndex < adjacency->nPanels; panelIndex++) {
+        frameIndices[panelIndex] = -1;
+    }
+
+    for (int frameIndex = 0; frameIndex < nPanels; frameIndex++) {
+        frameIndices[panelIndices[frameIndex]] = frameIndex;
+    }
+
+    int* degrees = new int[nPanels];
+    int maximumDegree = 0;
+    int nNeighbours = 0;
+
+    for (int frameIndex = 0; frameIndex < nPanels; frameIndex++) {
+        int panelIndex = panelIndices[frameIndex];
+        const int* neighbours = adjacency->getNeighbours(panelIndex);
+
+        degrees[frameIndex] = 0;
+
+        for (int neighbourIndex = 0; neighbourIndex < adjacency->getNeighboursCount(panelIndex); neighbourIndex++) {
+            if (frameIndices[neighbours[neighbourIndex]] != -1) {
+                degrees[frameIndex]++;
+            }
+        }
+
+        maximumDegree = degrees[frameIndex] > maximumDegree ? degrees[frameIndex] : maximumDegree;
+        nNeighbours += degrees[frameIndex];
+    }
+
+    bool regular = maximumDegree <= PROPAGATION_MAXIMUM_DEGREE_PER_ROW;
+
+    propagation->rowWidth = regular ? (maximumDegree > 0 ? maximumDegree : 1) : 0;
+    propagation->offsets = regular ? NULL : new int[nPanels + 1];
+    propagation->neighbours = new int[regular ? nPanels * propagation->rowWidth : nNeighbours];
+    propagation->reciprocals = new int32_t[nPanels];
+
+    int cursor = 0;
+
+    for (int frameIndex = 0; frameIndex < nPanels; frameIndex++) {
+        int panelIndex = panelIndices[frameIndex];
+        const int* neighbours = adjacency->getNeighbours(panelIndex);
+
+        if (!regular) {
+            propagation->offsets[frameIndex] = cursor;
+        }
+
+        for (int neighbourIndex = 0; neighbourIndex < adjacency->getNeighboursCount(panelIndex); neighbourIndex++) {
+            if (frameIndices[neighbours[neighbourIndex]] != -1) {
+                propagation->neighbours[cursor++] = frameIndices[neighbours[neighbourIndex]];
+            }
+        }
+
+        // Pad the row with the ghost panel.
+        while (regular && cursor < (frameIndex + 1) * propagation->rowWidth) {
+            propagation->neighbours[cursor++] = nPanels;
+        }
+
+        if (rule == PROPAGATION_RIPPLE) {
+            propagation->reciprocals[frameIndex] = degrees[frameIndex] > 0 ? (2 << RIPPLE_RECIPROCAL_BITS) / degrees[frameIndex] : 0;
+        } else {
+            propagation->reciprocals[frameIndex] = (1 << DIFFUSION_RECIPROCAL_BITS) / (degrees[frameIndex] + 1);
+        }
+    }
+
+    if (!regular) {
+        propagation->offsets[nPanels] = cursor;
+    }
+
+    delete [] frameIndices;
+    delete [] degrees;
+
+    for (int buffer = 0; buffer < 2; buffer++) {
+        if (rule == PROPAGATION_RIPPLE) {
+            propagation->heights[buffer] = new int16_t[nPanels + 1];
+            memset(propagation->heights[buffer], 0, (nPanels + 1) * sizeof(int16_t));
+        } else {
+            propagation->channels[buffer] = new uint8_t[(nPanels + 1) * FRAME_CHANNELS_COUNT];
+            memset(propagation->channels[buffer], 0, (nPanels + 1) * FRAME_CHANNELS_COUNT);
+        }
+    }
+
+    propagation->currentBuffer = 0;
+}
+
+void seedPanelPropagation(PanelPropagation* propagation, int frameIndex, const RGB_t& color) {
+    int current = propagation->currentBuffer;
+
+    if (propagation->rule == PROPAGATION_RIPPLE) {
+        propagation->heights[current][frameIndex] = PROPAGATION_MAXIMUM_HEIGHT;
+        propagation->color = color;
+    } else {
+        uint8_t* channels = propagation->channels[current] + frameIndex * FRAME_CHANNELS_COUNT;
+
+        channels[0] = clampPropagationByte(color.R);
+        channels[1] = clampPropagationByte(color.G);
+        channels[2] = clampPropagationByte(color.B);
+    }
+}
+
+bool stepPanelPropagation(PanelPropagation* propagation) {
+    int current = propagation->currentBuffer;
+    int next = 1 - current;
+    bool lit;
+
+    if (propagation->rule == PROPAGATION_RIPPLE) {
+        const int16_t* currentHeights = propagation->heights[current];
+        int16_t* nextHeights = propagation->heights[next];
+
+        switch (propagation->rowWidth) {
+        case 1: lit = stepRippleRows<1>(propagation->neighbours, propagation->reciprocals, currentHeights, nextHeights, propagation->nPanels, propagation->retention); break;
+        case 2: lit = stepRippleRows<2>(propagation->neighbours, propagation->reciprocals, currentHeights, nextHeights, propagation->nPanels, propagation->retention); break;
+        case 3: lit = stepRippleRows<3>(propagation->neighbours, propagation->reciprocals, currentHeights, nextHeights, propagation->nPanels, propagation->retention); break;
+        case 4: lit = stepRippleRows<4>(propagation->neighbours, propagation->reciprocals, currentHeights, nextHeights, propagation->nPanels, propagation->retention); break;
+        default: lit = stepRippleIrregular(propagation->offsets, propagation->neighbours, propagation->reciprocals, currentHeights, nextHeights, propagation->nPanels, propagation->retention); break;
+        }
+    } else {
+        const uint8_t* currentChannels = propagation->channels[current];
+        uint8_t* nextChannels = propagation->channels[next];
+
+        switch (propagation->rowWidth) {
+        case 1: lit = stepDiffusionRows<1>(propagation->neighbours, propagation->reciprocals, currentChannels, nextChannels, propagation->nPanels, propagation->retention); break;
+        case 2: lit = stepDiffusionRows<2>(propagation->neighbours, propagation->reciprocals, currentChannels, nextChannels, propagation->nPanels, propagation->retention); break;
+        case 3: lit = stepDiffusionRows<3>(propagation->neighbours, propagation->reciprocals, currentChannels, nextChannels, propagation->nPanels, propagation->retention); break;
+        case 4: lit = stepDiffusionRows<4>(propagation->neighbours, propagation->reciprocals, currentChannels, nextChannels, propagation->nPanels, propagation->retention); break;
+        default: lit = stepDiffusionIrregular(propagation->offsets, propagation->neighbours, propagation->reciprocals, currentChannels, nextChannels, propagation->nPanels, propagation->retention); break;
+        }
+    }
+
+    propagation->currentBuffer = next;
+
+    // The previous heights are what the next step subtracts, a new wave has to start from a flat surface.
+    if (!lit && propagation->rule == PROPAGATION_RIPPLE) {
+        memset(propagation->heights[current], 0, (propagation->nPanels + 1) * sizeof(int16_t));
+    }
+
+    return lit;
+}
+
+void renderPanelPropagation(const PanelPropagation* propagation, FrameLayer* layer) {
+    int current = propagation->currentBuffer;
+
+    if (propagation->rule == PROPAGATION_DIFFUSION) {
+        memcpy(layer->channels, propagation->channels[current], propagation->nPanels * FRAME_CHANNELS_COUNT);
+
+        return;
+    }
+
+    const int16_t* __restrict__ heights = propagation->heights[current];
+    uint8_t* __restrict__ channels = layer->channels;
+
+    int red = clampPropagationByte(propagation->color.R);
+    int green = clampPropagationByte(propagation->color.G);
+    int blue = clampPropagationByte(propagation->color.B);
+
+    // Crests and troughs are both lit, by their amplitude.
+    for (int panelIndex = 0; panelIndex < propagation->nPanels; panelIndex++) {
+        int amplitude = heights[panelIndex] < 0 ? -heights[panelIndex] : heights[panelIndex];
+
+        channels[panelIndex * FRAME_CHANNELS_COUNT] = red * amplitude / PROPAGATION_MAXIMUM_HEIGHT;
+        channels[panelIndex * FRAME_CHANNELS_COUNT + 1] = green * amplitude / PROPAGATION_MAXIMUM_HEIGHT;
+        channels[panelIndex * FRAME_CHANNELS_COUNT + 2] = blue * amplitude / PROPAGATION_MAXIMUM_HEIGHT;
+    }
+}
+
+void freePanelPropagation(PanelPropagation* propagation) {
+    delete [] propagation->offsets;
+    delete [] propagation->neighbours;
+    delete [] propagation->reciprocals;
+
+    for (int buffer = 0; buffer < 2; buffer++) {
+        delete [] propagation->heights[buffer];
+        delete [] propagation->channels[buffer];
+
+        propagation->heights[buffer] = NULL;
+        propagation->channels[buffer] = NULL;
+    }
+
+    propagation->nPanels = 0;
+    propagation->rowWidth = 0;
+    propagation->offsets = NULL;
+    propagation->neighbours = NULL;
+    propagation->reciprocals = NULL;
+    propagation->currentBuffer = 0;
+}
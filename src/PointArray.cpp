@@ -0,0 +1,77 @@
+/*
+ * PointArray.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "PointArray.h"
+
+/*
+ * The kernels below only read and write through restrict qualified locals with a unit stride,
+ * which is what the compiler needs to vectorize them.
+ */
+
+void translatePointArray(PointArray points, Vec2 offset) {
+    coord_t* __restrict__ xs = points.x;
+    coord_t* __restrict__ ys = points.y;
+
+    for (int index = 0; index < points.count; index++) {
+        xs[index] += offset.x;
+        ys[index] += offset.y;
+    }
+}
+
+void rotatePointArray(PointArray points, coord_t sine, coord_t cosine) {
+    coord_t* __restrict__ xs = points.x;
+    coord_t* __restrict__ ys = points.y;
+
+    for (int index = 0; index < points.count; index++) {
+        coord_t x = xs[index];
+        coord_t y = ys[index];
+
+        xs[index] = coordMultiplyAdd(x, cosine, y, -sine);
+        ys[index] = coordMultiplyAdd(x, sine, y, cosine);
+    }
+}
+
+void distancesToPoint(PointArray points, Vec2 point, coord_t* distances) {
+    const coord_t* __restrict__ xs = points.x;
+    const coord_t* __restrict__ ys = points.y;
+    coord_t* __restrict__ output = distances;
+
+    for (int index = 0; index < points.count; index++) {
+        output[index] = coordHypot(xs[index] - point.x, ys[index] - point.y);
+    }
+}
+
+void projectPointArray(PointArray points, coord_t sine, coord_t cosine, coord_t* projections) {
+    const coord_t* __restrict__ xs = points.x;
+    const coord_t* __restrict__ ys = points.y;
+    coord_t* __restrict__ output = projections;
+
+    for (int index = 0; index < points.count; index++) {
+        output[index] = coordMultiplyAdd(xs[index], cosine, ys[index], sine);
+    }
+}
+
+void boundsOfPointArray(PointArray points, Vec2* minimum, Vec2* maximum) {
+    if (points.count == 0) {
+        return;
+    }
+
+    Vec2 lower = points.get(0);
+    Vec2 upper = lower;
+
+    for (int index = 1; index < points.count; index++) {
+        coord_t x = points.x[index];
+        coord_t y = points.y[index];
+
+        lower.x = x < lower.x ? x : lower.x;
+        lower.y = y < lower.y ? y : lower.y;
+        upper.x = x > upper.x ? x : upper.x;
+        upper.y = y > upper.y ? y : upper.y;
+    }
+
+    *minimum = lower;
+    *maximum = upper;
+}
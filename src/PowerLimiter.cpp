@@ -0,0 +1,53 @@
+/*
+ * PowerLimiter.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "PowerLimiter.h"
+#include "FrameCompositor.h"
+
+/* Constants */
+
+static const uint32_t MAXIMUM_LEVEL = 255;
+
+/* API */
+
+void initPowerLimiter(PowerLimiter* limiter, int budget, int nPanels) {
+    budget = budget < 0 ? 0 : budget > FULL_POWER_BUDGET ? FULL_POWER_BUDGET : budget;
+
+    uint64_t fullChannelSum = (uint64_t)nPanels * FRAME_CHANNELS_COUNT * MAXIMUM_LEVEL;
+
+    limiter->maximumChannelSum = (uint32_t)(fullChannelSum * budget / FULL_POWER_BUDGET);
+    limiter->enabled = budget < FULL_POWER_BUDGET;
+    limiter->limitedFramesCount = 0;
+}
+
+bool applyPowerLimiter(PowerLimiter* limiter, uint8_t* channels, int nPanels) {
+    if (!limiter->enabled) {
+        return false;
+    }
+
+    uint8_t* __restrict__ output = channels;
+    uint32_t channelSum = 0;
+
+    // A plain reduction, the compiler widens and sums it in vector registers.
+    for (int index = 0; index < nPanels * FRAME_CHANNELS_COUNT; index++) {
+        channelSum += output[index];
+    }
+
+    if (channelSum <= limiter->maximumChannelSum) {
+        return false;
+    }
+
+    // Rounded down, so the scaled sum never ends up over the cap.
+    uint32_t scale = (uint32_t)(((uint64_t)limiter->maximumChannelSum << POWER_SCALE_BITS) / channelSum);
+
+    for (int index = 0; index < nPanels * FRAME_CHANNELS_COUNT; index++) {
+        output[index] = (output[index] * scale) >> POWER_SCALE_BITS;
+    }
+
+    limiter->limitedFramesCount++;
+
+    return true;
+}
@@ -0,0 +1,123 @@
+/*
+ * Profiler.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <string.h>
+
+#include "Profiler.h"
+
+/* Constants */
+
+static const char* PROFILE_PHASE_NAMES[PROFILE_PHASES_COUNT] = {
+    "getLayoutData",
+    "rotate",
+    "slice",
+    "adjacency",
+    "placement",
+    "sort",
+    "initPlugin",
+    "getPluginFrame",
+    "calibration",
+    "powerLimit"
+};
+
+/* Data */
+
+static LatencyHistogram profileHistograms[PROFILE_PHASES_COUNT];
+
+/* Helpers */
+
+static int highestBit(uint64_t value) {
+    return 63 - __builtin_clzll(value);
+}
+
+static int bucketIndexOf(uint64_t value) {
+    if (value < PROFILE_SUB_BUCKETS_COUNT) {
+        return (int)value;
+    }
+
+    int exponent = highestBit(value);
+
+    if (exponent > PROFILE_MAXIMUM_EXPONENT) {
+        return PROFILE_BUCKETS_COUNT - 1;
+    }
+
+    int subBucket = (int)(value >> (exponent - PROFILE_SUB_BUCKET_BITS)) & (PROFILE_SUB_BUCKETS_COUNT - 1);
+
+    return (exponent - PROFILE_SUB_BUCKET_BITS + 1) * PROFILE_SUB_BUCKETS_COUNT + subBucket;
+}
+
+static uint64_t bucketUpperBound(int bucketIndex) {
+    if (bucketIndex < PROFILE_SUB_BUCKETS_COUNT) {
+        return bucketIndex;
+    }
+
+    int exponent = bucketIndex / PROFILE_SUB_BUCKETS_COUNT + PROFILE_SUB_BUCKET_BITS - 1;
+    uint64_t subBucket = bucketIndex % PROFILE_SUB_BUCKETS_COUNT;
+    uint64_t width = (uint64_t)1 << (exponent - PROFILE_SUB_BUCKET_BITS);
+
+    return ((uint64_t)1 << exponent) + (subBucket + 1) * width - 1;
+}
+
+/* API */
+
+void recordProfileSample(int phase, uint64_t nanoseconds) {
+    LatencyHistogram& histogram = profileHistograms[phase];
+
+    histogram.buckets[bucketIndexOf(nanoseconds)]++;
+    histogram.count++;
+
+    if (nanoseconds > histogram.maximum) {
+        histogram.maximum = nanoseconds;
+    }
+}
+
+uint64_t getProfileQuantile(int phase, double quantile) {
+    const LatencyHistogram& histogram = profileHistograms[phase];
+
+    if (histogram.count == 0) {
+        return 0;
+    }
+
+    uint64_t targetCount = (uint64_t)(quantile * histogram.count + 0.5);
+    uint64_t cumulativeCount = 0;
+
+    if (targetCount == 0) {
+        targetCount = 1;
+    }
+
+    for (int bucketIndex = 0; bucketIndex < PROFILE_BUCKETS_COUNT; bucketIndex++) {
+        cumulativeCount += histogram.buckets[bucketIndex];
+
+        if (cumulativeCount >= targetCount) {
+            uint64_t upperBound = bucketUpperBound(bucketIndex);
+
+            return upperBound < histogram.maximum ? upperBound : histogram.maximum;
+        }
+    }
+
+    return histogram.maximum;
+}
+
+void dumpProfileHistograms(FILE* stream) {
+    for (int phase = 0; phase < PROFILE_PHASES_COUNT; phase++) {
+        const LatencyHistogram& histogram = profileHistograms[phase];
+
+        if (histogram.count == 0) {
+            continue;
+        }
+
+        fprintf(stream, "[profile] %-16s count %u p50 %lluus p99 %lluus max %lluus\n",
+                PROFILE_PHASE_NAMES[phase],
+                histogram.count,
+                (unsigned long long)(getProfileQuantile(phase, 0.5) / 1000),
+                (unsigned long long)(getProfileQuantile(phase, 0.99) / 1000),
+                (unsigned long long)(histogram.maximum / 1000));
+    }
+}
+
+void resetProfileHistograms() {
+    memset(profileHistograms, 0, sizeof(profileHistograms));
+}
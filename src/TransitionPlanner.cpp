@@ -0,0 +1,22 @@
+/*
+ * TransitionPlanner.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "TransitionPlanner.h"
+#include "FrameScheduler.h"
+
+void planTransition(int phaseDuration, int fadeTime, TransitionPlan* plan) {
+    int sleepTime = phaseDuration < MINIMUM_SLEEP_TIME ? MINIMUM_SLEEP_TIME : phaseDuration;
+    int transTime = fadeTime > sleepTime ? sleepTime : fadeTime;
+
+    plan->sleepTime = sleepTime;
+    plan->transTime = transTime < MINIMUM_TRANSITION_TIME ? MINIMUM_TRANSITION_TIME : transTime;
+}
+
+void applyTransitionPlan(const TransitionPlan* plan, Frame_t* frames, int nFrames) {
+    for (int index = 0; index < nFrames; index++) {
+        frames[index].transTime = plan->transTime;
+    }
+}